@@ -22,12 +22,23 @@ namespace reflex
 		struct any_deleter_func<void (*)(void *)> : std::true_type {};
 		template<>
 		struct any_deleter_func<void (*)(const void *)> : std::true_type {};
+
+		/* Inline buffer of a `basic_any`. Alignment is the declared alignment of the buffer rather than that of its address,
+		 * so that whether a value is placed inline depends only on its type and on the buffer's size & alignment parameters. */
+		struct any_buffer
+		{
+			std::byte *data = nullptr;
+			std::size_t size = 0;
+			std::size_t align = 0;
+		};
 	}
 
 	/** Type-erased generic object. */
 	class any
 	{
 		friend class type_info;
+		template<std::size_t, std::size_t>
+		friend class basic_any;
 		template<typename>
 		friend constexpr detail::any_funcs_t detail::make_any_funcs() noexcept;
 
@@ -67,9 +78,11 @@ namespace reflex
 
 		template<typename T, typename U = std::decay_t<T>>
 		static constexpr auto valid_deleter = std::is_empty_v<U> || detail::any_deleter_func<U>::value;
+		/* Non-trivial values are stored in-place as long as they can be relocated without throwing, using the hooks of their type. */
 		template<typename T>
-		static constexpr auto is_by_value = alignof(T) <= alignof(storage_t) && sizeof(T) <= (sizeof(storage_t) - sizeof(detail::type_flags)) &&
-		                                    std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
+		static constexpr auto is_by_value = alignof(T) <= alignof(storage_t) && sizeof(T) <= sizeof(storage_t) && std::is_nothrow_move_constructible_v<std::remove_cv_t<T>>;
+		template<typename T>
+		static constexpr auto is_trivial_value = std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>;
 
 		[[noreturn]] static REFLEX_PUBLIC void throw_bad_any_cast(type_info from_type, type_info to_type);
 		[[noreturn]] static REFLEX_PUBLIC void throw_bad_any_copy(type_info type);
@@ -90,8 +103,11 @@ namespace reflex
 			return *this;
 		}
 
-		constexpr any(any &&other) noexcept { swap(other); }
-		constexpr any &operator=(any &&other) noexcept
+		/** Moves the managed object of \a other into `this`.
+		 * @throw std::bad_alloc If \a other is a `basic_any` managing an inline value, which has to be moved to the heap. */
+		any(any &&other) { swap(other); }
+		/** @copydoc any(any &&) */
+		any &operator=(any &&other)
 		{
 			if (this != &other) swap(other);
 			return *this;
@@ -101,10 +117,10 @@ namespace reflex
 
 		/** Initializes `any` to manage a reference to \a ref. */
 		template<typename T>
-		explicit any(T &ref) requires (!std::same_as<std::decay_t<T>, any>) : any(type_of(ref), ref) {}
+		explicit any(T &ref) requires (!std::derived_from<std::decay_t<T>, any>) : any(type_of(ref), ref) {}
 		/** Initializes `any` to manage a reference to \a ref using type info \a type. */
 		template<typename T>
-		any(type_info type, T &ref) requires (!std::same_as<std::decay_t<T>, any>)
+		any(type_info type, T &ref) requires (!std::derived_from<std::decay_t<T>, any>)
 		{
 			this->type(type);
 			if constexpr (std::is_const_v<T>)
@@ -114,17 +130,17 @@ namespace reflex
 
 		/** Initializes `any` to manage an instance of \a T move-constructed from \a value. */
 		template<typename T>
-		explicit any(T &&value) requires (!std::same_as<std::decay_t<T>, any>) : any(std::in_place_type<std::decay_t<T>>, std::forward<T>(value)) {}
+		explicit any(T &&value) requires (!std::derived_from<std::decay_t<T>, any>) : any(std::in_place_type<std::decay_t<T>>, std::forward<T>(value)) {}
 		/** Initializes `any` to manage an instance of \a T move-constructed from \a value using type info \a type. */
 		template<typename T>
-		any(type_info type, T &&value) requires (!std::same_as<std::decay_t<T>, any>) : any(type, std::in_place_type<std::decay_t<T>>, std::forward<T>(value)) {}
+		any(type_info type, T &&value) requires (!std::derived_from<std::decay_t<T>, any>) : any(type, std::in_place_type<std::decay_t<T>>, std::forward<T>(value)) {}
 
 		/** Initializes `any` to manage in-place constructed instance of \a T with arguments \a args. */
 		template<typename T, typename... Args>
 		explicit any(std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...> : any(type_info::get<T>(), std::in_place_type<T>, std::forward<Args>(args)...) {}
 		/** Initializes `any` to manage in-place constructed instance of \a T with arguments \a args using type info \a type. */
 		template<typename T, typename... Args>
-		any(type_info type, std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...> { init_owned<T>(type, std::forward<Args>(args)...); }
+		any(type_info type, std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...> { init_owned<T>(type, {}, std::forward<Args>(args)...); }
 
 		/** Initializes `any` to take ownership of \a ptr with deleter \a Del.
 		 * @note Deleter must be an empty functor, a `void(void *)` or a `void(const void *)` function pointer. */
@@ -182,13 +198,13 @@ namespace reflex
 
 		/** Replaces the managed object with a reference to \a ref. */
 		template<typename T>
-		any &operator=(T &ref) requires (!std::same_as<std::remove_cv_t<T>, any>) { return assign(type_of(ref), ref); }
+		any &operator=(T &ref) requires (!std::derived_from<std::remove_cv_t<T>, any>) { return assign(type_of(ref), ref); }
 		/** @copydoc operator= */
 		template<typename T>
-		any &assign(T &ref) requires (!std::same_as<std::remove_cv_t<T>, any>) { return operator=(ref); }
+		any &assign(T &ref) requires (!std::derived_from<std::remove_cv_t<T>, any>) { return operator=(ref); }
 		/** Replaces the managed object with an in-place constructed instance of \a T with arguments \a args using type info \a type. */
 		template<typename T>
-		any &assign(type_info type, T &ref) requires (!std::same_as<std::remove_cv_t<T>, any>)
+		any &assign(type_info type, T &ref) requires (!std::derived_from<std::remove_cv_t<T>, any>)
 		{
 			destroy();
 			this->type(type);
@@ -208,8 +224,8 @@ namespace reflex
 		template<typename T, typename... Args>
 		any &assign(type_info type, std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...>
 		{
-			destroy();
-			init_owned<T>(type, std::forward<Args>(args)...);
+			reset();
+			init_owned<T>(type, {}, std::forward<Args>(args)...);
 			return *this;
 		}
 
@@ -227,7 +243,7 @@ namespace reflex
 		}
 
 		/** Returns type of the managed object. */
-		[[nodiscard]] type_info type() const noexcept { return {type_data(), m_db}; }
+		[[nodiscard]] type_info type() const noexcept { return {type_data()}; }
 
 		/** Checks if the `any` has a managed object (either value or reference). */
 		[[nodiscard]] bool empty() const noexcept { return type_data() == nullptr; }
@@ -255,6 +271,8 @@ namespace reflex
 		void reset()
 		{
 			destroy();
+			type(type_info{});
+			flags(detail::type_flags{});
 			m_storage = {};
 		}
 
@@ -330,7 +348,7 @@ namespace reflex
 		{
 			if constexpr (std::is_const_v<T>)
 				return std::as_const(*this).try_get<T>();
-			else if (type().name() == type_name_v<std::decay_t<T>>)
+			else if (is_same<std::decay_t<T>>())
 				return static_cast<T *>(data());
 			else
 				return nullptr;
@@ -340,7 +358,7 @@ namespace reflex
 		template<typename T>
 		[[nodiscard]] std::add_const_t<T> *try_get() const noexcept
 		{
-			if (type().name() == type_name_v<std::decay_t<T>>)
+			if (is_same<std::decay_t<T>>())
 				return static_cast<std::add_const_t<T> *>(data());
 			else
 				return nullptr;
@@ -376,8 +394,8 @@ namespace reflex
 		{
 			if constexpr (std::is_const_v<T>)
 				return std::as_const(*this).try_as<T>();
-			else if (type().name() != type_name_v<std::decay_t<T>>)
-				return static_cast<T *>(base_cast(type_name_v<std::decay_t<T>>));
+			else if (!is_same<std::decay_t<T>>())
+				return static_cast<T *>(base_cast(detail::hashed_type_name_v<std::decay_t<T>>));
 			else
 				return static_cast<T *>(data());
 		}
@@ -386,8 +404,8 @@ namespace reflex
 		template<typename T>
 		[[nodiscard]] std::add_const_t<T> *try_as() const
 		{
-			if (type().name() != type_name_v<std::decay_t<T>>)
-				return static_cast<std::add_const_t<T> *>(base_cast(type_name_v<std::decay_t<T>>));
+			if (!is_same<std::decay_t<T>>())
+				return static_cast<std::add_const_t<T> *>(base_cast(detail::hashed_type_name_v<std::decay_t<T>>));
 			else
 				return static_cast<std::add_const_t<T> *>(data());
 		}
@@ -422,11 +440,20 @@ namespace reflex
 		template<typename F>
 		[[nodiscard]] inline F facet() const;
 
-		/** Swaps contents of `this` and `other`. */
-		constexpr void swap(any &other) noexcept
+		/** Swaps contents of `this` and `other`.
+		 * @note Values stored in the inline buffer of a `basic_any` are moved to the heap, since the buffer size of `this` and \a other is not known.
+		 * @throw std::bad_alloc If an inline value cannot be moved to the heap. */
+		void swap(any &other)
 		{
-			swap_type(other);
-			std::swap(m_storage, other.m_storage);
+			if ((flags() | other.flags()) & (detail::is_inline | detail::is_nontrivial))
+			{
+				auto tmp = any{};
+				tmp.relocate_from(*this, {});
+				relocate_from(other, {});
+				other.relocate_from(tmp, {});
+			}
+			else
+				swap_value(other);
 		}
 
 		/** If the managed object of `this` is equal to the managed object of \a other, or if `this` and \a other are empty,
@@ -450,11 +477,13 @@ namespace reflex
 	private:
 		type_info type(type_info value) noexcept
 		{
-			const auto old_data = type_data(value.m_data);
-			const auto old_db = std::exchange(m_db, value.m_db);
-			return {old_data, old_db};
+			return {type_data(value.m_data)};
 		}
 
+		/* Checks if the managed object is of type \a T. Defined in database.hpp. */
+		template<typename T>
+		[[nodiscard]] inline bool is_same() const noexcept;
+
 		[[nodiscard]] void *local() noexcept { return m_storage.bytes; }
 		[[nodiscard]] const void *local() const noexcept { return m_storage.bytes; }
 
@@ -467,48 +496,93 @@ namespace reflex
 		template<typename T = void>
 		[[nodiscard]] T *external() const noexcept { return *m_storage.get<T *, sizeof(std::uintptr_t)>(); }
 
+		/* Checks if an instance of \a T can be placed in the inline buffer \a buffer of a `basic_any`. */
+		template<typename T>
+		[[nodiscard]] static constexpr bool fits_inline(detail::any_buffer buffer) noexcept
+		{
+			if constexpr (!std::is_nothrow_move_constructible_v<std::remove_cv_t<T>>)
+				return false;
+			else
+				return sizeof(T) <= buffer.size && alignof(T) <= buffer.align;
+		}
+
+		/* Checks if \a type provides hooks needed to relocate & destroy an in-place instance of \a T. Hooks are taken from \a type rather
+		 * than from `T`, and are missing if \a type describes a type that is not nothrow-movable. Defined in database.hpp. */
+		template<typename T>
+		[[nodiscard]] inline static bool has_hooks(type_info type) noexcept;
+
+		/* Values too large for the local storage are placed in the inline buffer \a buffer of a `basic_any` if possible, and are allocated otherwise.
+		 * Inline values are referenced via the external pointer, so that `any` does not need to know the size of the buffer. */
 		template<typename T, typename... Args>
-		void init_owned(type_info type, Args &&...args)
+		void init_owned(type_info type, detail::any_buffer buffer, Args &&...args)
 		{
-			this->type(type);
-			auto flags = detail::is_owned | (std::is_const_v<T> ? detail::is_const : detail::type_flags{});
-			if constexpr (!is_by_value < T >)
+			const auto flags = detail::is_owned | (std::is_const_v<T> ? detail::is_const : detail::type_flags{});
+			const auto in_place = flags | (is_trivial_value<T> ? detail::type_flags{} : detail::is_nontrivial);
+
+			/* Type & flags are only set once the value is constructed, so that `this` stays empty if construction throws. */
+			if constexpr (is_by_value<T>)
+				if (is_trivial_value<T> || has_hooks<T>(type))
+				{
+					/* Trivial local values are moved bitwise, every other in-place value is moved & destroyed via the hooks. */
+					std::construct_at(std::launder(static_cast<T *>(local())), std::forward<Args>(args)...);
+					this->type(type);
+					this->flags(in_place | detail::is_value);
+					return;
+				}
+			if (fits_inline<T>(buffer) && has_hooks<T>(type))
 			{
-				deleter(+[](void *ptr) { delete static_cast<std::remove_cv_t<T> *>(ptr); });
-				external(new std::remove_cv_t<T>(std::forward<Args>(args)...));
+				external(std::construct_at(reinterpret_cast<std::remove_cv_t<T> *>(buffer.data), std::forward<Args>(args)...));
+				this->type(type);
+				this->flags(in_place | detail::is_inline);
 			}
 			else
 			{
-				std::construct_at(std::launder(static_cast<T *>(local())), std::forward<Args>(args)...);
-				flags |= detail::is_value;
+				external(new std::remove_cv_t<T>(std::forward<Args>(args)...));
+				deleter(+[](void *ptr) { delete static_cast<std::remove_cv_t<T> *>(ptr); });
+				this->type(type);
+				this->flags(flags);
 			}
-			this->flags(flags);
 		}
 		template<typename T>
-		inline void copy_init(type_info type, T *ptr);
+		inline void copy_init(type_info type, T *ptr, detail::any_buffer buffer = {});
 		template<typename T>
-		inline void copy_assign(type_info type, T *ptr);
+		inline void copy_assign(type_info type, T *ptr, detail::any_buffer buffer = {});
 		REFLEX_PUBLIC void destroy();
 
+		/* Moves the managed object of \a other into empty `this`, using the inline buffer \a buffer if possible. In-place values
+		 * are relocated via the hooks of their type, since they cannot be moved bitwise. Leaves \a other empty. */
+		REFLEX_PUBLIC void relocate_from(any &other, detail::any_buffer buffer);
+
+		void swap_value(any &other) noexcept
+		{
+			swap_type(other);
+			std::swap(m_storage, other.m_storage);
+		}
+
 		template<typename T, typename U>
-		void impl_copy_from(type_info type, U *data)
+		void impl_copy_from(type_info type, U *data, detail::any_buffer buffer)
 		{
 			using other_t = take_const_t<T, U>;
 			if constexpr (std::is_copy_constructible_v<T>)
-				init_owned<T>(type, *static_cast<other_t *>(data));
+				init_owned<T>(type, buffer, *static_cast<other_t *>(data));
 			else
 				throw_bad_any_copy(type);
 		}
 		template<typename T>
-		void copy_from(type_info type, const void *cdata, void *data)
+		void copy_from(type_info type, const void *cdata, void *data, detail::any_buffer buffer)
 		{
 			if (cdata != nullptr)
-				impl_copy_from<T>(type, cdata);
+				impl_copy_from<T>(type, cdata, buffer);
 			else
-				impl_copy_from<T>(type, data);
+				impl_copy_from<T>(type, data, buffer);
+		}
+		template<typename T>
+		void move_from(type_info type, void *data, detail::any_buffer buffer)
+		{
+			init_owned<T>(type, buffer, std::move(*static_cast<T *>(data)));
 		}
 		template<typename T>
-		void assign_from(type_info type, const void *cdata, void *data)
+		void assign_from(type_info type, const void *cdata, void *data, detail::any_buffer buffer)
 		{
 			/* Attempt a copy-assignment for cases where `target` is by-value and assignable from source. */
 			if constexpr (std::is_copy_assignable_v<T>)
@@ -520,11 +594,13 @@ namespace reflex
 						*tgt = *detail::void_cast<T>(data);
 					return;
 				}
-			copy_from<T>(type, cdata, data);
+			/* `this` is reset before copying, so that it is left empty rather than destroyed twice if the copy throws. */
+			reset();
+			copy_from<T>(type, cdata, data, buffer);
 		}
 
-		[[nodiscard]] REFLEX_PUBLIC void *base_cast(std::string_view) const;
-		[[nodiscard]] REFLEX_PUBLIC any value_conv(std::string_view) const;
+		[[nodiscard]] REFLEX_PUBLIC void *base_cast(detail::hashed_name) const;
+		[[nodiscard]] REFLEX_PUBLIC any value_conv(detail::hashed_name) const;
 
 #ifdef NDEBUG
 		/* Flags are stored within the type data pointer. */
@@ -553,7 +629,6 @@ namespace reflex
 		constexpr void swap_type(any &other) noexcept
 		{
 			std::swap(m_data_ptr_flags, other.m_data_ptr_flags);
-			std::swap(m_db, other.m_db);
 		}
 
 		std::uintptr_t m_data_ptr_flags = 0;
@@ -568,29 +643,129 @@ namespace reflex
 		{
 			std::swap(m_type, other.m_type);
 			std::swap(m_flags, other.m_flags);
-			std::swap(m_db, other.m_db);
 		}
 
 		detail::type_data *m_type = nullptr;
 		detail::type_flags m_flags = {};
 #endif
 
-		detail::database_impl *m_db = nullptr;
 		storage_t m_storage;
 	};
 
-	constexpr void swap(any &a, any &b) noexcept { a.swap(b); }
+	inline void swap(any &a, any &b) { a.swap(b); }
+
+	/** Type-erased generic object with an inline buffer of \a N bytes aligned to \a A.
+	 * Nothrow-movable values that do not fit into the local storage of `any`, but fit into \a N bytes and require at most \a A alignment,
+	 * are placed into the inline buffer instead of being allocated.
+	 * Since `basic_any` derives from `any`, it can be passed by reference to any function accepting `any`.
+	 * @note Inline values are moved to the heap when a `basic_any` is moved or swapped through a reference to `any`. Such moves may throw
+	 * `std::bad_alloc`, while moves & swaps between `basic_any` objects of the same buffer size and alignment never allocate. */
+	template<std::size_t N, std::size_t A>
+	class basic_any : public any
+	{
+	public:
+		/** Initializes an empty `basic_any`. */
+		constexpr basic_any() noexcept = default;
+
+		/** Copies value of the managed object of \a other.
+		 * @throw bad_any_copy If the underlying type of \a other is not copy-constructible. */
+		basic_any(const basic_any &other) : basic_any(static_cast<const any &>(other)) {}
+		/** @copydoc basic_any */
+		basic_any(const any &other) { copy_init(other.type(), other.cdata(), inline_buffer()); }
+		/** If types of `this` and \a other are the same and `this` is not a reference, copy-assigns the managed object.
+		 * Otherwise, destroys `this` and copy-constructs the managed object from \a other.
+		 * @throw bad_any_copy If the managed object cannot be copy-assigned and the underlying type of \a other is not copy-constructible. */
+		basic_any &operator=(const basic_any &other) { return operator=(static_cast<const any &>(other)); }
+		/** @copydoc operator= */
+		basic_any &operator=(const any &other)
+		{
+			if (this != &other) copy_assign(other.type(), other.cdata(), inline_buffer());
+			return *this;
+		}
+
+		basic_any(basic_any &&other) noexcept { swap(other); }
+		basic_any &operator=(basic_any &&other) noexcept
+		{
+			if (this != &other) swap(other);
+			return *this;
+		}
+		/** Moves the managed object of \a other into `this`.
+		 * @throw std::bad_alloc If \a other manages an inline value, which has to be moved to the heap. */
+		basic_any(any &&other) { any::swap(other); }
+		/** @copydoc basic_any(any &&) */
+		basic_any &operator=(any &&other)
+		{
+			if (this != &other) any::swap(other);
+			return *this;
+		}
+
+		/** Initializes `basic_any` to manage a reference to \a ref. */
+		template<typename T>
+		explicit basic_any(T &ref) requires (!std::derived_from<std::decay_t<T>, any>) : any(ref) {}
+		/** Initializes `basic_any` to manage an instance of \a T move-constructed from \a value. */
+		template<typename T>
+		explicit basic_any(T &&value) requires (!std::derived_from<std::decay_t<T>, any>) : basic_any(std::in_place_type<std::decay_t<T>>, std::forward<T>(value)) {}
+
+		/** Initializes `basic_any` to manage in-place constructed instance of \a T with arguments \a args. */
+		template<typename T, typename... Args>
+		explicit basic_any(std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...> : basic_any(type_info::get<T>(), std::in_place_type<T>, std::forward<Args>(args)...) {}
+		/** Initializes `basic_any` to manage in-place constructed instance of \a T with arguments \a args using type info \a type. */
+		template<typename T, typename... Args>
+		basic_any(type_info type, std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...> { init_owned<T>(type, inline_buffer(), std::forward<Args>(args)...); }
+
+		using any::operator=;
+		using any::assign;
+
+		/** Replaces the managed object with an in-place constructed instance of \a T with arguments \a args. */
+		template<typename T, typename... Args>
+		basic_any &assign(std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...>
+		{
+			return assign(type_info::get<T>(), std::in_place_type<T>, std::forward<Args>(args)...);
+		}
+		/** Replaces the managed object with an in-place constructed instance of \a T with arguments \a args using type info \a type. */
+		template<typename T, typename... Args>
+		basic_any &assign(type_info type, std::in_place_type_t<T>, Args &&...args) requires std::constructible_from<T, Args...>
+		{
+			reset();
+			init_owned<T>(type, inline_buffer(), std::forward<Args>(args)...);
+			return *this;
+		}
+
+		using any::swap;
+
+		/** Swaps contents of `this` and `other`. Inline values are relocated between buffers of the same size and alignment, and are never allocated. */
+		void swap(basic_any &other) noexcept
+		{
+			if ((flags() | other.flags()) & (detail::is_inline | detail::is_nontrivial))
+			{
+				auto tmp = basic_any{};
+				tmp.relocate_from(*this, tmp.inline_buffer());
+				relocate_from(other, inline_buffer());
+				other.relocate_from(tmp, other.inline_buffer());
+			}
+			else
+				swap_value(other);
+		}
+
+	private:
+		[[nodiscard]] detail::any_buffer inline_buffer() noexcept { return {m_buffer, N, A}; }
+
+		alignas(A) std::byte m_buffer[N] = {};
+	};
+
+	template<std::size_t N, std::size_t A>
+	inline void swap(basic_any<N, A> &a, basic_any<N, A> &b) noexcept { a.swap(b); }
 
 	/** Returns the type info of the object managed by \a value. Equivalent to `value.type()`. */
 	template<typename T>
-	[[nodiscard]] inline type_info type_of(T &&value) requires std::same_as<std::decay_t<T>, any> { return value.type(); }
+	[[nodiscard]] inline type_info type_of(T &&value) requires std::derived_from<std::decay_t<T>, any> { return value.type(); }
 
 	/** Returns an `any` referencing the object managed by \a other. */
 	template<typename T>
-	[[nodiscard]] inline any forward_any(T &other) requires(std::same_as<std::decay_t<T>, any>) { return other.ref(); }
+	[[nodiscard]] inline any forward_any(T &other) requires(std::derived_from<std::decay_t<T>, any>) { return other.ref(); }
 	/** Returns an `any` referencing the object at \a instance. */
 	template<typename T>
-	[[nodiscard]] inline any forward_any(T &instance) requires (!std::same_as<std::decay_t<T>, any>) { return any{instance}; }
+	[[nodiscard]] inline any forward_any(T &instance) requires (!std::derived_from<std::decay_t<T>, any>) { return any{instance}; }
 
 	/** Returns an `any` containing a move-constructed instance of \a value. */
 	template<typename T>
@@ -607,7 +782,7 @@ namespace reflex
 	any type_info::attribute(type_info type) const { return attribute(type.name()); }
 
 	template<typename T>
-	bool type_info::has_enumeration(T &&value) const requires (!std::same_as<std::decay_t<T>, any>) { return has_enumeration(forward_any(std::forward<T>(value))); }
+	bool type_info::has_enumeration(T &&value) const requires (!std::derived_from<std::decay_t<T>, any>) { return has_enumeration(forward_any(std::forward<T>(value))); }
 
 	template<std::size_t N>
 	any type_info::construct(std::span<any, N> args) const { return construct(std::span<any>{args}); }
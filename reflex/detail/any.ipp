@@ -12,10 +12,31 @@ namespace reflex
 		/* If `this` is empty, or `type` is invalid, return empty any. */
 		if (empty() || !type.valid()) return {};
 
-		/* If `type` is the same as or is a base of `this`, return reference to `this`. */
+		/* If `type` is the same as `this`, return reference to `this`. */
 		if (type == this->type()) return ref();
-		/* If `this` is convertible to `type`, convert `this` to `type`. */
-		if (const auto *base_ptr = base_cast(type.name()); base_ptr != nullptr)
+		/* Otherwise, use the cached cast path from `this` to `type`. */
+		if (type.m_data->db == type_data()->db) [[likely]]
+		{
+			/* Cast path is owned by the flattened table of `this`, which must stay pinned while the path is used. */
+			const auto guard = detail::table_guard{};
+			const auto &path = type.m_data->db->find_cast(*type_data(), *type.m_data);
+			switch (path.kind)
+			{
+				case detail::cast_kind::identity: return ref();
+				case detail::cast_kind::base:
+				{
+					const auto base_ptr = path.ancestor->cast(cdata());
+					return is_const() ? any{type, base_ptr} : any{type, const_cast<void *>(base_ptr)};
+				}
+				case detail::cast_kind::conv: return path.conv(cdata());
+				case detail::cast_kind::base_conv: return path.conv(path.ancestor->cast(cdata()));
+				case detail::cast_kind::chain: return (*path.chain)(cdata());
+				default: return {};
+			}
+		}
+
+		/* If `type` is a base of `this`, return reference to the base. */
+		if (const auto *base_ptr = base_cast(type.name_key()); base_ptr != nullptr)
 		{
 			if (!is_const())
 				return any{type, const_cast<void *>(base_ptr)};
@@ -23,53 +44,61 @@ namespace reflex
 				return any{type, base_ptr};
 		}
 		/* Otherwise, attempt to convert by-value. */
-		return value_conv(type.name());
+		return value_conv(type.name_key());
 	}
 	any any::try_cast(type_info type) const
 	{
 		/* If `this` is empty, or `type` is invalid, return empty any. */
 		if (empty() || !type.valid()) return {};
 
-		/* If `type` is the same as or is a base of `this`, return reference to `this`. */
+		/* If `type` is the same as `this`, return reference to `this`. */
 		if (type == this->type()) return ref();
-		/* If `this` is convertible to `type`, convert `this` to `type`. */
-		if (const auto *base_ptr = base_cast(type.name()); base_ptr != nullptr)
+		/* Otherwise, use the cached cast path from `this` to `type`. */
+		if (type.m_data->db == type_data()->db) [[likely]]
+		{
+			/* Cast path is owned by the flattened table of `this`, which must stay pinned while the path is used. */
+			const auto guard = detail::table_guard{};
+			const auto &path = type.m_data->db->find_cast(*type_data(), *type.m_data);
+			switch (path.kind)
+			{
+				case detail::cast_kind::identity: return ref();
+				case detail::cast_kind::base: return any{type, path.ancestor->cast(cdata())};
+				case detail::cast_kind::conv: return path.conv(cdata());
+				case detail::cast_kind::base_conv: return path.conv(path.ancestor->cast(cdata()));
+				case detail::cast_kind::chain: return (*path.chain)(cdata());
+				default: return {};
+			}
+		}
+
+		/* If `type` is a base of `this`, return reference to the base. */
+		if (const auto *base_ptr = base_cast(type.name_key()); base_ptr != nullptr)
 			return any{type, base_ptr};
 		/* Otherwise, attempt to convert by-value. */
-		return value_conv(type.name());
+		return value_conv(type.name_key());
 	}
 
-	void *any::base_cast(std::string_view base_name) const
+	void *any::base_cast(detail::hashed_name base_name) const
 	{
-		const auto data = type_data();
-
-		/* If `type` is an immediate base of `this`, attempt to cast through that. */
-		if (const auto *base = data->find_base(base_name, *m_db); base != nullptr)
-			return const_cast<void *>(base->cast_func(cdata()));
-
-		/* Otherwise, recursively cast through a base type. */
-		for (auto [_, base]: data->bases)
-		{
-			const auto *base_ptr = base.cast_func(cdata());
-			const auto base_type = type_info{base.type, *m_db};
-			auto candidate = any{base_type, base_ptr}.base_cast(base_name);
-			if (candidate != nullptr) return candidate;
-		}
-		return nullptr;
+		/* Flattened ancestor table contains all transitive bases of the type, together with their cast paths. */
+		auto &db = *type_data()->db;
+		const auto guard = detail::table_guard{};
+		const auto ancestor = type_data()->init_once(db).find_base(base_name, db);
+		return ancestor != nullptr ? const_cast<void *>(ancestor->cast(cdata())) : nullptr;
 	}
-	any any::value_conv(std::string_view base_name) const
+	any any::value_conv(detail::hashed_name base_name) const
 	{
-		const auto data = type_data();
+		auto &db = *type_data()->db;
+		const auto data = &type_data()->init_once(db);
 
 		/* If `this` is directly convertible to `name`, use the existing conversion. */
-		if (const auto *conv = data->find_conv(base_name, *m_db); conv != nullptr)
+		if (const auto *conv = data->find_conv(base_name, db); conv != nullptr)
 			return (*conv)(cdata());
 
 		/* Otherwise, recursively convert through a base type. */
 		for (auto [_, base]: data->bases)
 		{
-			const auto *base_ptr = base.cast_func(cdata());
-			const auto base_type = type_info{base.type, *m_db};
+			const auto *base_ptr = base.cast(cdata());
+			const auto base_type = type_info{base.type, db};
 			auto candidate = any{base_type, base_ptr}.value_conv(base_name);
 			if (!candidate.empty()) return candidate;
 		}
@@ -81,8 +110,24 @@ namespace reflex
 		/* Bail if empty or non-owning. */
 		if (empty() || is_ref()) return;
 
-		if (!(flags() & detail::is_value))
+		/* Non-trivial local & inline values are destroyed in-place. */
+		if (!(flags() & (detail::is_value | detail::is_inline)))
 			(*deleter())(external());
+		else if (flags() & detail::is_nontrivial)
+		{
+			if (const auto func = type_data()->any_funcs.destroy; func != nullptr)
+				func(const_cast<void *>(cdata()));
+		}
+	}
+	void any::relocate_from(any &other, detail::any_buffer buffer)
+	{
+		/* Allocated, referenced & trivial local values can be moved bitwise. */
+		if (!(other.flags() & (detail::is_inline | detail::is_nontrivial)))
+			return swap_value(other);
+
+		(this->*(other.type_data()->any_funcs.move_init))(other.type(), const_cast<void *>(other.cdata()), buffer);
+		flags(flags() | (other.flags() & detail::is_const));
+		other.reset();
 	}
 
 	bool any::operator==(const any &other) const
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <limits>
 #include <list>
 
 #include "../delegate.hpp"
@@ -15,35 +16,304 @@ namespace reflex
 {
 	namespace detail
 	{
-		std::size_t type_hash::operator()(const type_info &value) const { return tpp::seahash_hash<type_info>{}(value); }
+		std::size_t type_hash::operator()(const type_info &value) const { return std::hash<type_info>{}(value); }
 
 		bool type_eq::operator()(const type_info &a, const type_info &b) const { return a == b; }
-		bool type_eq::operator()(const std::string &a, const type_info &b) const { return std::string_view{a} == b; }
-		bool type_eq::operator()(const type_info &a, const std::string &b) const { return a == std::string_view{b}; }
-		bool type_eq::operator()(const type_info &a, const std::string_view &b) const { return a == b; }
-		bool type_eq::operator()(const std::string_view &a, const type_info &b) const { return a == b; }
 
-		using vtab_table = tpp::dense_map<std::string_view, const void *>;
+		using vtab_table = tpp::dense_map<std::string_view, const void *, type_hash, type_eq>;
+		/* Maps names of facet group vtable tuples to names of the grouped vtables. */
+		using vtab_group_table = tpp::dense_map<std::string_view, std::vector<std::string_view>, type_hash, type_eq>;
 		using attr_table = tpp::dense_map<std::string_view, any, type_hash, type_eq>;
-		using enum_table = tpp::dense_map<std::string, any, type_hash, type_eq>;
+		using enum_table = tpp::dense_map<std::string_view, any, type_hash, type_eq>;
+
+		/* Returns a copy of \a str interned in the string arena of database \a db. */
+		[[nodiscard]] REFLEX_PUBLIC std::string_view intern_name(database_impl &db, std::string_view str);
+
+		/* Type handle that caches the resolved entry, so that repeated resolutions follow a plain pointer instead of invoking the handle. */
+		class type_ref
+		{
+		public:
+			constexpr type_ref() noexcept = default;
+			type_ref(const type_ref &other) : m_handle(other.m_handle), m_data(other.m_data.load(std::memory_order_relaxed)) {}
+			type_ref &operator=(const type_ref &other)
+			{
+				m_handle = other.m_handle;
+				m_data.store(other.m_data.load(std::memory_order_relaxed), std::memory_order_relaxed);
+				return *this;
+			}
+
+			/* Function references are decayed, so that they are stored by the delegate as function pointers. */
+			template<typename F> requires (!std::same_as<std::decay_t<F>, type_ref> && std::constructible_from<type_handle, std::decay_t<F>>)
+			constexpr type_ref(F &&handle) : m_handle(std::decay_t<F>(std::forward<F>(handle))) {}
+			/* Initializes the handle with an already resolved entry \a data. */
+			template<typename F>
+			type_ref(F &&handle, type_data *data) : m_handle(std::decay_t<F>(std::forward<F>(handle))), m_data(data) {}
+
+			[[nodiscard]] constexpr explicit operator bool() const noexcept { return static_cast<bool>(m_handle); }
+
+			/* Defined after `type_data`. */
+			[[nodiscard]] inline type_data *operator()(database_impl &db) const;
+
+		private:
+			type_handle m_handle;
+			/* Cached entry is validated against the owning database, since handles may be shared by multiple databases. */
+			mutable std::atomic<type_data *> m_data = nullptr;
+		};
+
+		/* Single derived-to-base cast. Non-virtual bases are stored as a fixed pointer offset, virtual bases use a cast function. */
+		struct base_step
+		{
+			base_step() noexcept = default;
+			constexpr base_step(std::ptrdiff_t offset) noexcept : offset(offset) {}
+			constexpr base_step(base_cast func) noexcept : func(func) {}
+
+			[[nodiscard]] const void *operator()(const void *ptr) const noexcept
+			{
+				if (func != nullptr) [[unlikely]] return func(ptr);
+				return static_cast<const std::byte *>(ptr) + offset;
+			}
+
+			base_cast func = nullptr;
+			std::ptrdiff_t offset = 0;
+		};
 
 		struct type_base
 		{
-			type_handle type;
-			base_cast cast_func;
+			type_ref type;
+			base_step cast;
+		};
+
+		using base_table = tpp::dense_map<std::string_view, type_base, type_hash, type_eq>;
+
+		/* Transitive ancestor of a type, together with the chain of casts from the type to the ancestor.
+		 * Consecutive fixed-offset casts are collapsed into a single offset, so that the path is empty unless a virtual base is involved. */
+		struct type_ancestor
+		{
+			[[nodiscard]] const void *cast(const void *ptr) const noexcept
+			{
+				ptr = static_cast<const std::byte *>(ptr) + offset;
+				for (auto step: path) ptr = step(ptr);
+				return ptr;
+			}
+
+			type_data *type = nullptr;
+			std::ptrdiff_t offset = 0;
+			std::vector<base_step> path;
+		};
+
+		/* Bloom filter over names of a type's own and inherited metadata, used to reject failed lookups without probing every table. */
+		class name_filter
+		{
+			constexpr static std::size_t bits = 512;
+
+		public:
+			enum kind_t : std::uint64_t
+			{
+				base_name = 1,
+				conv_name,
+				vtab_name,
+			};
+
+			constexpr void insert(kind_t kind, std::uint64_t hash) noexcept
+			{
+				const auto h = hash_mix(hash, kind);
+				set(h % bits);
+				set((h >> 32) % bits);
+			}
+			[[nodiscard]] constexpr bool may_contain(kind_t kind, std::uint64_t hash) const noexcept
+			{
+				const auto h = hash_mix(hash, kind);
+				return test(h % bits) && test((h >> 32) % bits);
+			}
+
+		private:
+			constexpr void set(std::uint64_t bit) noexcept { m_words[bit / 64] |= std::uint64_t{1} << (bit % 64); }
+			[[nodiscard]] constexpr bool test(std::uint64_t bit) const noexcept { return (m_words[bit / 64] >> (bit % 64)) & 1; }
+
+			std::array<std::uint64_t, bits / 64> m_words = {};
+		};
+
+		/* Strategy used to cast a source type to a target type. */
+		enum class cast_kind : std::uint8_t
+		{
+			none,
+			identity,
+			/* Source is cast to the `ancestor` base. */
+			base,
+			/* Source is converted by-value using `conv`. */
+			conv,
+			/* Source is cast to the `ancestor` base, which is then converted by-value using `conv`. */
+			base_conv,
+			/* Source is converted by-value through a chain of intermediate types. */
+			chain,
+		};
+
+		struct cast_path;
+
+		/* Precomposed multi-hop conversion. Every hop converts the result of the previous one, optionally through one of its bases. */
+		struct conv_chain
+		{
+			[[nodiscard]] inline any operator()(const void *data) const;
+
+			std::vector<cast_path> hops;
+		};
+		/* Resolved cast path from a source type to a target type. Conversion functions are copied out of conversion
+		 * tables, since conversion tables are re-allocated whenever a conversion is added. */
+		struct cast_path
+		{
+			cast_kind kind = cast_kind::none;
+			const type_ancestor *ancestor = nullptr;
+			delegate<any(const void *)> conv;
+			std::unique_ptr<const conv_chain> chain;
+		};
+
+		any conv_chain::operator()(const void *data) const
+		{
+			auto result = any{};
+			for (auto &hop: hops)
+			{
+				if (hop.ancestor != nullptr) data = hop.ancestor->cast(data);
+				if ((result = hop.conv(data)).empty()) [[unlikely]] break;
+				data = result.cdata();
+			}
+			return result;
+		}
+
+		/* Lock-free cache of cast paths from a single source type, keyed by the target type entry. Entries are prepended
+		 * to per-bucket lists and never removed, so that readers never observe a freed entry while the cache is alive. */
+		class cast_cache
+		{
+			constexpr static std::size_t bucket_count = 16;
+
+			struct entry_t
+			{
+				const type_data *to;
+				cast_path path;
+				const entry_t *next;
+			};
+
+		public:
+			cast_cache() noexcept = default;
+			cast_cache(const cast_cache &) = delete;
+			cast_cache &operator=(const cast_cache &) = delete;
+
+			~cast_cache()
+			{
+				for (auto &bucket: m_buckets)
+					for (auto entry = bucket.load(std::memory_order_relaxed); entry != nullptr;)
+						delete std::exchange(entry, entry->next);
+			}
+
+			[[nodiscard]] const cast_path *find(const type_data *to) const noexcept
+			{
+				for (auto entry = bucket(to).load(std::memory_order_acquire); entry != nullptr; entry = entry->next)
+					if (entry->to == to) return &entry->path;
+				return nullptr;
+			}
+			/* Inserts a path to \a to, or returns the existing path if another thread has inserted one first. */
+			const cast_path &insert(const type_data *to, cast_path path)
+			{
+				auto &head = bucket(to);
+				auto entry = std::unique_ptr<entry_t>{new entry_t{to, std::move(path), head.load(std::memory_order_acquire)}};
+				for (;;)
+				{
+					if (head.compare_exchange_weak(entry->next, entry.get(), std::memory_order_acq_rel, std::memory_order_acquire))
+						return entry.release()->path;
+					for (auto other = entry->next; other != nullptr; other = other->next)
+						if (other->to == to) return other->path;
+				}
+			}
+
+		private:
+			[[nodiscard]] std::atomic<const entry_t *> &bucket(const type_data *to) const noexcept
+			{
+				const auto hash = hash_mix(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(to)), 0);
+				return m_buckets[static_cast<std::size_t>(hash % bucket_count)];
+			}
+
+			mutable std::array<std::atomic<const entry_t *>, bucket_count> m_buckets = {};
 		};
 
-		using base_table = tpp::dense_map<std::string_view, type_base>;
+		/* Epoch-based reclamation of flattened ancestor tables, which are read without locking. Readers pin the current epoch
+		 * while accessing tables, and tables dropped in an epoch are only freed once no thread has that or an earlier epoch pinned. */
+		class table_epoch
+		{
+			struct record;
+
+		public:
+			/* Pins are per-thread and may be nested. */
+			REFLEX_PUBLIC static void pin();
+			REFLEX_PUBLIC static void unpin() noexcept;
+
+			/* Advances the epoch. Returns the epoch tables dropped before the call are retired in. */
+			REFLEX_PUBLIC static std::uint64_t retire() noexcept;
+			/* Returns the oldest epoch pinned by any thread, or the current epoch if none is pinned. Tables retired in earlier epochs may be freed. */
+			[[nodiscard]] REFLEX_PUBLIC static std::uint64_t oldest() noexcept;
+
+		private:
+			static std::atomic<std::uint64_t> &epoch() noexcept;
+			static std::atomic<record *> &records() noexcept;
+			static record &this_record();
+		};
+
+		/* Pins the table epoch for the lifetime of the guard. References to flattened tables must not outlive the guard. */
+		struct table_guard
+		{
+			table_guard() { table_epoch::pin(); }
+			~table_guard() { table_epoch::unpin(); }
+
+			table_guard(const table_guard &) = delete;
+			table_guard &operator=(const table_guard &) = delete;
+		};
+
+		/* Flattened table of all transitive ancestors of a type. Immutable, except for the lock-free cache of cast paths. */
+		struct ancestor_table
+		{
+			/* Checks if the ancestry bitset contains a type with the specified database-local ID. */
+			[[nodiscard]] bool contains(std::uint32_t id) const noexcept
+			{
+				const auto word = id / 64;
+				return word < mask.size() && (mask[word] >> (id % 64)) & 1;
+			}
+
+			tpp::dense_map<std::string_view, type_ancestor, type_hash, type_eq> entries;
+			/* Bitset of ancestor IDs, used for constant-time subtype tests. */
+			std::vector<std::uint64_t> mask;
+			/* Filter over bases, conversions and facets of the type and all of its ancestors. */
+			name_filter names;
+
+			/* Facet vtables of the type and all of its ancestors. Vtables of the type itself and of nearer ancestors take precedence. */
+			vtab_table vtabs;
+			/* Resolved vtables of facet groups, in the order of grouped facets. */
+			tpp::dense_map<std::string_view, std::vector<const void *>, type_hash, type_eq> vtab_groups;
+
+			/* Cast paths from the type, dropped together with the table once the type or any type the paths go through change. */
+			mutable cast_cache casts;
+		};
+
+		/* Drops flattened ancestor tables of \a data and of all types depending on it after bases, conversions or facets of \a data have changed. */
+		REFLEX_PUBLIC void invalidate_tables(database_impl &db, const type_data &data);
 
 		template<typename T, typename B>
 		[[nodiscard]] inline static type_base make_type_base() noexcept
 		{
-			constexpr auto cast = [](const void *ptr) noexcept -> const void *
+			/* Down-casts from virtual bases are ill-formed, so a valid down-cast implies a fixed base offset. */
+			if constexpr (requires(const B *ptr) { static_cast<const T *>(ptr); })
 			{
-				auto *base = static_cast<std::add_const_t<B> *>(static_cast<std::add_const_t<T> *>(ptr));
-				return static_cast<const void *>(base);
-			};
-			return {data_factory<B>, cast};
+				/* Offset is computed using a suitably aligned non-null dummy address, since null pointers are not adjusted. */
+				const auto derived = reinterpret_cast<const T *>(std::uintptr_t{alignof(T)} << 8);
+				const auto base = static_cast<const B *>(derived);
+				return {data_factory<B>, reinterpret_cast<const std::byte *>(base) - reinterpret_cast<const std::byte *>(derived)};
+			}
+			else
+			{
+				constexpr auto cast = [](const void *ptr) noexcept -> const void *
+				{
+					auto *base = static_cast<std::add_const_t<B> *>(static_cast<std::add_const_t<T> *>(ptr));
+					return static_cast<const void *>(base);
+				};
+				return {data_factory<B>, base_cast{cast}};
+			}
 		}
 
 		struct type_conv
@@ -52,7 +322,7 @@ namespace reflex
 			template<typename F>
 			explicit type_conv(F &&conv) : func(std::forward<F>(conv)) {}
 			template<typename From, typename To, typename F>
-			type_conv(std::in_place_type_t<From>, std::in_place_type_t<To>, F &&conv)
+			type_conv(std::in_place_type_t<From>, std::in_place_type_t<To>, F &&conv) : type(data_factory<To>)
 			{
 				if constexpr (!std::is_invocable_r_v<any, F, const void *>)
 					func = [f = std::forward<F>(conv)](const void *data) { return make_any<To>(std::invoke(f, *static_cast<const From *>(data))); };
@@ -63,9 +333,13 @@ namespace reflex
 			[[nodiscard]] any operator()(const void *data) const { return func(data); }
 
 			delegate<any(const void *)> func;
+			/* Handle of the target type if known at compile time, used to reflect intermediate types of conversion chains. */
+			type_handle type;
+			/* Set for conversions known to preserve all values of the source type. Preferred by multi-hop conversion search. */
+			bool lossless = false;
 		};
 
-		using conv_table = tpp::dense_map<std::string_view, type_conv>;
+		using conv_table = tpp::dense_map<std::string_view, type_conv, type_hash, type_eq>;
 
 		template<typename From, typename To, typename F>
 		[[nodiscard]] inline static type_conv make_type_conv(F &&conv)
@@ -73,16 +347,57 @@ namespace reflex
 			return {std::in_place_type<From>, std::in_place_type<To>, std::forward<F>(conv)};
 		}
 		template<typename From, typename To>
+		[[nodiscard]] constexpr bool is_lossless_conv() noexcept
+		{
+			if constexpr (std::is_enum_v<From>)
+				return std::same_as<std::underlying_type_t<From>, To>;
+			else if constexpr (!std::is_arithmetic_v<From> || !std::is_arithmetic_v<To>)
+				return false;
+			else if constexpr (std::is_floating_point_v<From>)
+			{
+				using from_limits = std::numeric_limits<From>;
+				using to_limits = std::numeric_limits<To>;
+				return std::is_floating_point_v<To> && to_limits::digits >= from_limits::digits && to_limits::max_exponent >= from_limits::max_exponent;
+			}
+			else if constexpr (std::is_floating_point_v<To>)
+				return std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits;
+			else
+				return std::numeric_limits<To>::digits >= std::numeric_limits<From>::digits && (std::is_signed_v<To> || !std::is_signed_v<From>);
+		}
+		template<typename From, typename To>
 		[[nodiscard]] inline static type_conv make_type_conv() noexcept
 		{
-			return make_type_conv<From, To>([](auto &value) { return static_cast<To>(value); });
+			auto result = make_type_conv<From, To>([](auto &value) { return static_cast<To>(value); });
+			result.lossless = is_lossless_conv<From, To>();
+			return result;
 		}
 
+		/* Argument data consists of the type name view, a key word, the type factory and the resolved type pointer. The key holds
+		 * the name hash with argument flags in its low bits, so that exact signature matches compare a single word per argument. */
 		struct arg_data
 		{
-			[[nodiscard]] static bool match_exact(const auto &a, const auto &b)
+			constexpr static std::uint64_t flags_mask = is_const | is_value;
+
+			[[nodiscard]] constexpr static std::uint64_t make_key(std::uint64_t hash, type_flags flags) noexcept { return (hash & ~flags_mask) | (flags & flags_mask); }
+
+			[[nodiscard]] static bool match_signature(std::span<const arg_data> a, std::span<const arg_data> b) noexcept
 			{
-				return std::ranges::equal(a, b, [](auto &&a, auto &&b) { return a == b; });
+				if (a.size() != b.size())
+					return false;
+
+				/* Compare key words first, names are only compared to rule out hash collisions. */
+				for (std::size_t i = 0; i < a.size(); ++i)
+					if (a[i].key != b[i].key) return false;
+				for (std::size_t i = 0; i < a.size(); ++i)
+					if (a[i].name.data() != b[i].name.data() && a[i].name != b[i].name) return false;
+				return true;
+			}
+			[[nodiscard]] static bool match_exact(const auto &a, const auto &b, database_impl &db)
+			{
+				if constexpr (std::convertible_to<decltype(b), std::span<const arg_data>>)
+					return match_signature(a, b);
+				else
+					return std::ranges::equal(a, b, [&](auto &&a, auto &&b) { return a.same_as(b, db); });
 			}
 			[[nodiscard]] static bool match_compatible(const auto &a, const auto &b, database_impl &db)
 			{
@@ -90,31 +405,34 @@ namespace reflex
 			}
 
 			arg_data() noexcept = default;
-			template<typename F>
-			arg_data(std::string_view name, F &&type, type_flags flags) : name(name), type(std::forward<F>(type)), flags(flags) {}
+			/* Initializes argument of an already resolved type \a data. */
+			arg_data(std::string_view name, type_data *data, type_flags flags) noexcept : name(name), key(make_key(name_hash(name), flags)), data(data) {}
 			template<typename T>
-			arg_data(std::in_place_type_t<T>) noexcept : name(type_name_v<std::decay_t<T>>), type(data_factory<std::decay_t<T>>)
+			constexpr arg_data(std::in_place_type_t<T>) noexcept : name(type_name_v<std::decay_t<T>>), factory(data_factory<std::decay_t<T>>)
 			{
+				auto flags = type_flags{};
 				if constexpr (!std::is_lvalue_reference_v<T>) flags |= is_value;
 				if constexpr (std::is_const_v<std::remove_reference_t<T>>) flags |= is_const;
+				key = make_key(type_hash_v<std::decay_t<T>>, flags);
 			}
 
+			[[nodiscard]] constexpr type_flags flags() const noexcept { return static_cast<type_flags>(key & flags_mask); }
+			[[nodiscard]] type_data *type(database_impl &db) const { return data != nullptr ? data : factory(db); }
+
 			[[nodiscard]] inline bool compatible(const any &other, database_impl &db) const;
 			[[nodiscard]] inline bool compatible(const arg_data &other, database_impl &db) const;
 
-			[[nodiscard]] friend constexpr bool operator==(const arg_data &a, const any &b) noexcept
-			{
-				return static_cast<int>(a.flags) == ((b.is_ref() << 1) | int{b.is_const()}) && a.name == b.type().name();
-			}
-			[[nodiscard]] friend constexpr bool operator==(const arg_data &a, const arg_data &b) noexcept
-			{
-				return a.flags == b.flags && a.name == b.name;
-			}
+			/* Exact matches against `any` compare type entries instead of names. */
+			[[nodiscard]] inline bool same_as(const any &other, database_impl &db) const;
+			[[nodiscard]] inline bool same_as(const arg_data &other, database_impl &db) const;
 
-			/* Type name is cached separately in order to enable quick comparisons. */
+			/* Type name is cached separately in order to enable quick base & conversion lookups. */
 			std::string_view name;
-			type_handle type = {};
-			type_flags flags = {};
+			std::uint64_t key = 0;
+
+			/* Compile-time arguments resolve their type via the cached factory, runtime arguments reference the type directly. */
+			type_data *(*factory)(database_impl &) = nullptr;
+			type_data *data = nullptr;
 		};
 
 		template<typename T>
@@ -177,8 +495,13 @@ namespace reflex
 
 		struct any_funcs_t
 		{
-			void (any::*copy_init)(type_info, const void *, void *) = nullptr;
-			void (any::*copy_assign)(type_info, const void *, void *) = nullptr;
+			void (any::*copy_init)(type_info, const void *, void *, detail::any_buffer) = nullptr;
+			void (any::*copy_assign)(type_info, const void *, void *, detail::any_buffer) = nullptr;
+
+			/* Hooks used to relocate & destroy values stored in-place by `any`. Only set for nothrow-movable types.
+			 * Relocation allocates if the value does not fit into the target buffer, and may throw in that case only. */
+			void (any::*move_init)(type_info, void *, detail::any_buffer) = nullptr;
+			void (*destroy)(void *) noexcept = nullptr;
 		};
 
 		template<typename T>
@@ -187,6 +510,12 @@ namespace reflex
 			any_funcs_t result;
 			result.copy_init = &any::copy_from<T>;
 			result.copy_assign = &any::assign_from<T>;
+
+			using U = std::remove_cv_t<T>;
+			if constexpr (std::is_nothrow_move_constructible_v<U>)
+				result.move_init = &any::move_from<U>;
+			if constexpr (std::is_nothrow_move_constructible_v<U> && !std::is_trivially_destructible_v<U>)
+				result.destroy = +[](void *ptr) noexcept { std::destroy_at(static_cast<U *>(ptr)); };
 			return result;
 		}
 
@@ -198,6 +527,7 @@ namespace reflex
 				attrs.clear();
 				enums.clear();
 				vtabs.clear();
+				vtab_groups.clear();
 				bases.clear();
 				ctors.clear();
 				convs.clear();
@@ -209,6 +539,8 @@ namespace reflex
 			enum_table enums;
 			/* Facet vtables. */
 			vtab_table vtabs;
+			/* Facet groups implemented by the type. */
+			vtab_group_table vtab_groups;
 			/* Base types. */
 			base_table bases;
 
@@ -229,13 +561,15 @@ namespace reflex
 			any_funcs_t any_funcs;
 
 			std::string_view name;
+			/* Compile-time hash of `name`, used for lookups of the type & it's metadata. */
+			std::uint64_t name_hash = 0;
 			type_flags flags = {};
 
 			std::size_t size = 0;
 			std::size_t alignment = 0;
 
-			type_handle remove_pointer = {};
-			type_handle remove_extent = {};
+			type_ref remove_pointer = {};
+			type_ref remove_extent = {};
 			std::size_t extent = 0;
 		};
 
@@ -244,6 +578,19 @@ namespace reflex
 		{
 			type_data(const constant_type_data &cdata) : constant_type_data(cdata) {}
 
+			/* Dense database-local ID, used for quick type identity checks & hashing. */
+			std::uint32_t id = 0;
+			/* Database that owns the entry, used to validate cached per-type entry pointers. */
+			database_impl *db = nullptr;
+			/* State of dynamic metadata. Metadata may be initialized after insertion, either lazily or by a prewarm worker. */
+			std::atomic<std::uint8_t> init_state = init_pending;
+			/* Flattened ancestors of the type, built on first use and dropped once the type or any of its ancestors change. */
+			mutable std::atomic<const ancestor_table *> ancestors = nullptr;
+			/* Types whose flattened tables were built from the type, and count of times the type's table was dropped.
+			 * Used to scope invalidation to the changed type and its descendants. Guarded by the ancestor lock of the database. */
+			mutable std::vector<const type_data *> dependents;
+			mutable std::uint64_t table_version = 0;
+
 			template<typename T>
 			inline static void init_cmp_vtable(type_data &data);
 
@@ -278,43 +625,47 @@ namespace reflex
 				}
 			}
 
-			bool walk_bases(database_impl &db, auto &&p) const { return std::any_of(bases.begin(), bases.end(), [&](auto &&e) { return p(e.second.type(db)); }); }
+			bool walk_bases(database_impl &db, auto &&p) const { return std::any_of(bases.begin(), bases.end(), [&](auto &&e) { return p(&e.second.type(db)->init_once(db)); }); }
 
-			[[nodiscard]] any *find_attr(std::string_view name) noexcept
+			[[nodiscard]] any *find_attr(hashed_name name) noexcept
 			{
 				const auto pos = attrs.find(name);
 				return pos != attrs.end() ? &pos->second : nullptr;
 			}
-			[[nodiscard]] const any *find_attr(std::string_view name) const noexcept
+			[[nodiscard]] const any *find_attr(hashed_name name) const noexcept
 			{
 				const auto pos = attrs.find(name);
 				return pos != attrs.end() ? &pos->second : nullptr;
 			}
 
-			[[nodiscard]] const void *find_vtab(std::string_view name, database_impl &db) const
+			[[nodiscard]] const void *find_vtab(hashed_name name, database_impl &db) const
 			{
-				auto pos = vtabs.find(name);
-				if (pos != vtabs.end()) return pos->second;
+				const auto guard = table_guard{};
+				const auto &table = flat_bases(db);
+				if (!table.names.may_contain(name_filter::vtab_name, name.hash))
+					return nullptr;
 
-				const auto pred = [&](const auto *t) { return (pos = t->vtabs.find(name)) != t->vtabs.end(); };
-				return walk_bases(db, pred) ? pos->second : nullptr;
+				const auto pos = table.vtabs.find(name);
+				return pos != table.vtabs.end() ? pos->second : nullptr;
 			}
-
-			[[nodiscard]] type_base *find_base(std::string_view name, database_impl &db)
+			[[nodiscard]] const void *const *find_vtab_group(hashed_name name, database_impl &db) const
 			{
-				auto pos = bases.find(name);
-				if (pos != bases.end()) return &pos->second;
-
-				const auto pred = [&](auto *t) { return (pos = t->bases.find(name)) != t->bases.end(); };
-				return walk_bases(db, pred) ? &pos->second : nullptr;
+				const auto &table = flat_bases(db);
+				const auto pos = table.vtab_groups.find(name);
+				return pos != table.vtab_groups.end() ? pos->second.data() : nullptr;
 			}
-			[[nodiscard]] const type_base *find_base(std::string_view name, database_impl &db) const
+
+			/* Returns flattened ancestors of the type. Must be called with the table epoch pinned. Defined in database.hpp. */
+			[[nodiscard]] inline const ancestor_table &flat_bases(database_impl &db) const;
+
+			[[nodiscard]] const type_ancestor *find_base(hashed_name name, database_impl &db) const
 			{
-				auto pos = bases.find(name);
-				if (pos != bases.end()) return &pos->second;
+				const auto &table = flat_bases(db);
+				if (!table.names.may_contain(name_filter::base_name, name.hash))
+					return nullptr;
 
-				const auto pred = [&](const auto *t) { return (pos = t->bases.find(name)) != t->bases.end(); };
-				return walk_bases(db, pred) ? &pos->second : nullptr;
+				const auto pos = table.entries.find(name);
+				return pos != table.entries.end() ? &pos->second : nullptr;
 			}
 
 			[[nodiscard]] any *find_enum(const any &value)
@@ -338,20 +689,20 @@ namespace reflex
 				return pos != enums.end() ? &pos->second : nullptr;
 			}
 
-			[[nodiscard]] type_ctor *find_exact_ctor(const auto &args) noexcept
+			[[nodiscard]] type_ctor *find_exact_ctor(const auto &args, database_impl &db)
 			{
 				for (auto &ctor: ctors)
 				{
-					if (arg_data::match_exact(ctor.args, args))
+					if (arg_data::match_exact(ctor.args, args, db))
 						return &ctor;
 				}
 				return nullptr;
 			}
-			[[nodiscard]] const type_ctor *find_exact_ctor(const auto &args) const noexcept
+			[[nodiscard]] const type_ctor *find_exact_ctor(const auto &args, database_impl &db) const
 			{
 				for (auto &ctor: ctors)
 				{
-					if (arg_data::match_exact(ctor.args, args))
+					if (arg_data::match_exact(ctor.args, args, db))
 						return &ctor;
 				}
 				return nullptr;
@@ -362,7 +713,7 @@ namespace reflex
 				type_ctor *candidate = nullptr;
 				for (auto &ctor: ctors)
 				{
-					if (arg_data::match_exact(ctor.args, args))
+					if (arg_data::match_exact(ctor.args, args, db))
 						return &ctor;
 					if (arg_data::match_compatible(ctor.args, args, db))
 						candidate = &ctor;
@@ -374,7 +725,7 @@ namespace reflex
 				const type_ctor *candidate = nullptr;
 				for (auto &ctor: ctors)
 				{
-					if (arg_data::match_exact(ctor.args, args))
+					if (arg_data::match_exact(ctor.args, args, db))
 						return &ctor;
 					if (arg_data::match_compatible(ctor.args, args, db))
 						candidate = &ctor;
@@ -382,16 +733,24 @@ namespace reflex
 				return candidate;
 			}
 
-			[[nodiscard]] type_conv *find_conv(std::string_view name, database_impl &db)
+			[[nodiscard]] type_conv *find_conv(hashed_name name, database_impl &db)
 			{
+				const auto guard = table_guard{};
+				if (!flat_bases(db).names.may_contain(name_filter::conv_name, name.hash))
+					return nullptr;
+
 				auto pos = convs.find(name);
 				if (pos != convs.end()) return &pos->second;
 
 				const auto pred = [&](auto *t) { return (pos = t->convs.find(name)) != t->convs.end(); };
 				return walk_bases(db, pred) ? &pos->second : nullptr;
 			}
-			[[nodiscard]] const type_conv *find_conv(std::string_view name, database_impl &db) const
+			[[nodiscard]] const type_conv *find_conv(hashed_name name, database_impl &db) const
 			{
+				const auto guard = table_guard{};
+				if (!flat_bases(db).names.may_contain(name_filter::conv_name, name.hash))
+					return nullptr;
+
 				auto pos = convs.find(name);
 				if (pos != convs.end()) return &pos->second;
 
@@ -404,42 +763,103 @@ namespace reflex
 				init_func(*this, db);
 				return *this;
 			}
-			type_data &reset(database_impl &db)
+			/* Clears all dynamically-initialized metadata. Metadata will be re-initialized by the database, or on next use.
+			 * Waits for initialization in progress by other threads, since metadata must not be cleared while it is written. */
+			REFLEX_PUBLIC REFLEX_COLD type_data &reset();
+
+			/* Returns the entry with initialized dynamic metadata, initializing it if needed. */
+			type_data &init_once(database_impl &db)
 			{
-				/* Clear all dynamically-initialized metadata. */
-				dynamic_type_data::clear();
-				/* Re-initialize the metadata. */
-				return init(db);
+				if (init_state.load(std::memory_order_acquire) != init_done) [[unlikely]]
+					deferred_init(db);
+				return *this;
 			}
+
+		private:
+			constexpr static std::uint8_t init_pending = 0;
+			constexpr static std::uint8_t init_running = 1;
+			constexpr static std::uint8_t init_done = 2;
+
+			/* Initialization state of a thread. Entries being initialized by the thread are kept on a stack, since type initializers
+			 * may query their own type. The entry the thread waits for is recorded in order to detect cyclic initialization across threads. */
+			struct init_thread
+			{
+				struct frame
+				{
+					const type_data *data;
+					const frame *prev;
+				};
+
+				const frame *top = nullptr;
+				/* Guarded by the wait graph lock. */
+				const type_data *waiting = nullptr;
+			};
+
+			static init_thread &this_init_thread() noexcept;
+			[[nodiscard]] bool init_by_this_thread() const noexcept;
+			/* Waits for the thread initializing the entry. Returns `false` without waiting if that thread waits for an entry
+			 * initialized by \a thread, either directly or through other threads, since waiting would deadlock. */
+			bool wait_init(init_thread &thread, std::uint8_t state) const;
+
+			/* Thread currently initializing the entry, if any. */
+			std::atomic<const init_thread *> init_owner = nullptr;
+
+			REFLEX_PUBLIC REFLEX_COLD void deferred_init(database_impl &db);
 		};
 
+		bool arg_data::same_as(const any &other, database_impl &db) const
+		{
+			return static_cast<int>(flags()) == ((other.is_ref() << 1) | int{other.is_const()}) && type(db) == other.type().m_data;
+		}
+		bool arg_data::same_as(const arg_data &other, database_impl &) const
+		{
+			/* Argument types must not be resolved here, since exact matches are used during type initialization.
+			 * Names of compile-time arguments point to `type_name_v` storage, so compare pointers first. */
+			return key == other.key && (name.data() == other.name.data() || name == other.name);
+		}
+
 		bool arg_data::compatible(const any &other, database_impl &db) const
 		{
-			if (flags < int{other.is_const()} ? is_const : type_flags{})
+			if (flags() < int{other.is_const()} ? is_const : type_flags{})
 				return false;
 
-			if (const auto other_name = other.type().name(); name != other_name)
+			if (const auto other_name = other.type().name_key(); name != other_name.value)
 			{
-				if (const auto this_type = type(db); !this_type->find_base(other_name, db))
-					return (flags >= is_const) && this_type->find_conv(other_name, db);
+				const auto guard = table_guard{};
+				if (const auto this_type = &type(db)->init_once(db); !this_type->find_base(other_name, db))
+					return (flags() >= is_const) && this_type->find_conv(other_name, db);
 			}
 			return true;
 		}
 		bool arg_data::compatible(const arg_data &other, database_impl &db) const
 		{
-			if (flags < (other.flags & is_const))
+			if (flags() < (other.flags() & is_const))
 				return false;
 
 			if (name != other.name)
 			{
-				if (const auto this_type = type(db); !this_type->find_base(other.name, db))
-					return (flags >= is_const) && this_type->find_conv(other.name, db);
+				/* Use the full name hash of the resolved entry, since `key` has argument flags in its low bits. */
+				const auto other_type = other.type(db);
+				const auto other_name = hashed_name{other_type->name, other_type->name_hash};
+				const auto guard = table_guard{};
+				if (const auto this_type = &type(db)->init_once(db); !this_type->find_base(other_name, db))
+					return (flags() >= is_const) && this_type->find_conv(other_name, db);
 			}
 			return true;
 		}
 
+		type_data *type_ref::operator()(database_impl &db) const
+		{
+			if (const auto data = m_data.load(std::memory_order_acquire); data != nullptr && data->db == &db) [[likely]]
+				return data;
+
+			const auto data = m_handle(db);
+			m_data.store(data, std::memory_order_release);
+			return data;
+		}
+
 		template<typename T>
-		constexpr constant_type_data::constant_type_data(std::in_place_type_t<T>) noexcept : init_func(&type_data::impl_init<T>), any_funcs(make_any_funcs<T>())
+		constexpr constant_type_data::constant_type_data(std::in_place_type_t<T>) noexcept : init_func(&type_data::impl_init<T>), any_funcs(make_any_funcs<T>()), name(type_name_v<T>), name_hash(type_hash_v<T>)
 		{
 			if constexpr (std::same_as<T, void>)
 				flags |= type_flags::is_void;
@@ -461,16 +881,16 @@ namespace reflex
 				if constexpr (std::signed_integral<T>) flags |= type_flags::is_signed_int;
 				if constexpr (std::unsigned_integral<T>) flags |= type_flags::is_unsigned_int;
 
-				remove_pointer = data_factory<std::decay_t<std::remove_pointer_t<T>>>;
-				remove_extent = data_factory<std::decay_t<std::remove_extent_t<T>>>;
+				remove_pointer = type_ref{data_factory<std::decay_t<std::remove_pointer_t<T>>>};
+				remove_extent = type_ref{data_factory<std::decay_t<std::remove_extent_t<T>>>};
 				extent = std::extent_v<T>;
 			}
 		}
 	}
 
-	constexpr bool argument_info::operator==(const argument_info &other) const noexcept
+	bool argument_info::operator==(const argument_info &other) const
 	{
-		return m_data == other.m_data || (m_data && other.m_data && *m_data == *other.m_data);
+		return m_data == other.m_data || (m_data && other.m_data && m_data->same_as(*other.m_data, *m_db));
 	}
 
 	template<typename... Args>
@@ -482,8 +902,8 @@ namespace reflex
 		m_data.reserve(args.size());
 		for (auto [type, flags]: args)
 		{
-			m_data.emplace_back(type.name(), [data = type.m_data](auto &&) { return data; }, static_cast<detail::type_flags>(flags));
-			m_db = type.m_db;
+			m_data.emplace_back(type.name(), type.m_data, static_cast<detail::type_flags>(flags));
+			m_db = type.database();
 		}
 	}
 
@@ -507,7 +927,7 @@ namespace reflex
 		[[nodiscard]] constexpr const argument_info &operator*() const noexcept { return m_value; }
 		[[nodiscard]] constexpr const argument_info *operator->() const noexcept { return &m_value; }
 
-		[[nodiscard]] constexpr bool operator==(const pointer &) const noexcept = default;
+		[[nodiscard]] bool operator==(const pointer &) const = default;
 
 	private:
 		argument_info m_value;
@@ -691,12 +1111,20 @@ namespace reflex
 		detail::database_impl *m_db = nullptr;
 	};
 
-	typename constructor_view::iterator constructor_view::begin() const noexcept { return {m_view->begin(), m_db}; }
+	bool constructor_view::empty() const noexcept { return m_type->ctors.empty(); }
+	typename constructor_view::size_type constructor_view::size() const noexcept { return m_type->ctors.size(); }
+
+	typename constructor_view::iterator constructor_view::begin() const noexcept { return {m_type->ctors.begin(), m_type->db}; }
 	typename constructor_view::iterator constructor_view::cbegin() const noexcept { return begin(); }
-	typename constructor_view::iterator constructor_view::end() const noexcept { return {m_view->end(), m_db}; }
+	typename constructor_view::iterator constructor_view::end() const noexcept { return {m_type->ctors.end(), m_type->db}; }
 	typename constructor_view::iterator constructor_view::cend() const noexcept { return end(); }
 
+	detail::type_data *type_info::dynamic_data() const { return &m_data->init_once(*m_data->db); }
+	detail::database_impl *type_info::database() const noexcept { return valid() ? m_data->db : nullptr; }
+
 	constexpr std::string_view type_info::name() const noexcept { return valid() ? m_data->name : std::string_view{}; }
+	constexpr std::uint32_t type_info::id() const noexcept { return valid() ? m_data->id : invalid_id; }
+	constexpr detail::hashed_name type_info::name_key() const noexcept { return valid() ? detail::hashed_name{m_data->name, m_data->name_hash} : detail::hashed_name{std::string_view{}, 0}; }
 
 	constexpr std::size_t type_info::size() const noexcept { return valid() ? m_data->size : 0; }
 	constexpr std::size_t type_info::extent() const noexcept { return valid() ? m_data->extent : 0; }
@@ -717,10 +1145,10 @@ namespace reflex
 	constexpr bool type_info::is_unsigned_integral() const noexcept { return valid() && (m_data->flags & detail::is_unsigned_int); }
 	constexpr bool type_info::is_arithmetic() const noexcept { return valid() && (m_data->flags & detail::is_arithmetic); }
 
-	type_info type_info::remove_extent() const noexcept { return valid() && m_data->remove_extent ? type_info{m_data->remove_extent, *m_db} : type_info{}; }
-	type_info type_info::remove_pointer() const noexcept { return valid() && m_data->remove_pointer ? type_info{m_data->remove_pointer, *m_db} : type_info{}; }
+	type_info type_info::remove_extent() const noexcept { return valid() && m_data->remove_extent ? type_info{m_data->remove_extent(*database())} : type_info{}; }
+	type_info type_info::remove_pointer() const noexcept { return valid() && m_data->remove_pointer ? type_info{m_data->remove_pointer(*database())} : type_info{}; }
 
-	constexpr constructor_view type_info::constructors() const noexcept { return valid() ? constructor_view{&m_data->ctors, m_db} : constructor_view{}; }
+	constructor_view type_info::constructors() const { return valid() ? constructor_view{dynamic_data()} : constructor_view{}; }
 
 	template<typename ...Args>
 	bool type_info::constructible_from() const
@@ -736,20 +1164,23 @@ namespace reflex
 	}
 	bool type_info::constructible_from(const argument_list &args) const { return constructible_from(args.m_data); }
 
+	/* Copy functions are taken from the source type, since `this` may be empty or of a different type. */
 	template<typename T>
-	void any::copy_init(type_info type, T *ptr)
+	void any::copy_init(type_info type, T *ptr, detail::any_buffer buffer)
 	{
+		if (!type.valid()) return;
 		if constexpr (std::is_const_v<T>)
-			(this->*(type_data()->any_funcs.copy_init))(type, ptr, nullptr);
+			(this->*(type.m_data->any_funcs.copy_init))(type, ptr, nullptr, buffer);
 		else
-			(this->*(type_data()->any_funcs.copy_init))(type, nullptr, ptr);
+			(this->*(type.m_data->any_funcs.copy_init))(type, nullptr, ptr, buffer);
 	}
 	template<typename T>
-	void any::copy_assign(type_info type, T *ptr)
+	void any::copy_assign(type_info type, T *ptr, detail::any_buffer buffer)
 	{
+		if (!type.valid()) return reset();
 		if constexpr (std::is_const_v<T>)
-			(this->*(type_data()->any_funcs.copy_assign))(type, ptr, nullptr);
+			(this->*(type.m_data->any_funcs.copy_assign))(type, ptr, nullptr, buffer);
 		else
-			(this->*(type_data()->any_funcs.copy_assign))(type, nullptr, ptr);
+			(this->*(type.m_data->any_funcs.copy_assign))(type, nullptr, ptr, buffer);
 	}
 }
\ No newline at end of file
@@ -4,14 +4,220 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
 #include "factory.hpp"
 
+#ifndef REFLEX_DATABASE_SHARDS
+#define REFLEX_DATABASE_SHARDS 1
+#endif
+#ifndef REFLEX_CONVERSION_HOPS
+#define REFLEX_CONVERSION_HOPS 1
+#endif
+
 namespace reflex
 {
 	namespace detail
 	{
-		struct database_impl : shared_spinlock
+		/* Insert-only open-addressing index of type entries, used to look up types without locking the database.
+		 * Lookups are wait-free, while insertions must be synchronized externally. Since entries are never removed,
+		 * grown or dropped tables are retired instead of being freed, as readers may still reference them. Retired tables
+		 * are released together with the index. Tables retired by growth never exceed the size of the current table. */
+		class type_index
 		{
+			struct table
+			{
+				explicit table(std::size_t size) : slots(size), mask(size - 1) {}
+
+				std::vector<std::atomic<type_data *>> slots;
+				std::size_t mask;
+			};
+
+			constexpr static std::size_t min_size = 64;
+
+		public:
+			type_index() = default;
+			type_index(const type_index &) = delete;
+			type_index &operator=(const type_index &) = delete;
+
+			[[nodiscard]] type_data *find(std::string_view name, std::uint64_t hash) const noexcept
+			{
+				const auto *tab = m_table.load(std::memory_order_acquire);
+				if (tab == nullptr) return nullptr;
+
+				for (auto i = static_cast<std::size_t>(hash);; ++i)
+				{
+					const auto entry = tab->slots[i & tab->mask].load(std::memory_order_acquire);
+					if (entry == nullptr)
+						return nullptr;
+					if (entry->name_hash == hash && entry->name == name)
+						return entry;
+				}
+			}
+			/* Empties the index. Current table is retired rather than freed, since concurrent lookups may still probe it. */
+			void retire() noexcept
+			{
+				m_table.store(nullptr, std::memory_order_release);
+				m_size = 0;
+			}
+			void insert(type_data *entry)
+			{
+				/* Keep the load factor at or below 0.5, so that misses terminate quickly. */
+				auto *tab = m_table.load(std::memory_order_relaxed);
+				if (tab == nullptr || (m_size + 1) * 2 > tab->slots.size())
+					tab = grow(tab == nullptr ? min_size : tab->slots.size() * 2);
+
+				place(*tab, entry);
+				++m_size;
+			}
+
+		private:
+			static void place(table &tab, type_data *entry) noexcept
+			{
+				for (auto i = static_cast<std::size_t>(entry->name_hash);; ++i)
+				{
+					auto &slot = tab.slots[i & tab.mask];
+					if (slot.load(std::memory_order_relaxed) == nullptr)
+						return slot.store(entry, std::memory_order_release);
+				}
+			}
+			table *grow(std::size_t size)
+			{
+				auto &tab = *m_tables.emplace_back(std::make_unique<table>(size));
+				if (const auto *old = m_table.load(std::memory_order_relaxed); old != nullptr)
+				{
+					for (auto &slot: old->slots)
+						if (const auto entry = slot.load(std::memory_order_relaxed); entry != nullptr)
+							place(tab, entry);
+				}
+
+				/* Publish the new table only after it is fully populated. */
+				m_table.store(&tab, std::memory_order_release);
+				return &tab;
+			}
+
+			std::atomic<table *> m_table = {};
+			std::vector<std::unique_ptr<table>> m_tables;
+			std::size_t m_size = 0;
+		};
+
+		/* Append-only arena of interned strings. Strings are copied into contiguous pages which are never moved or freed
+		 * for the lifetime of the arena, so that views of interned strings remain stable. Interning is internally synchronized. */
+		class string_arena
+		{
+			constexpr static std::size_t page_size = 4096;
+
+		public:
+			string_arena() = default;
+			string_arena(const string_arena &) = delete;
+			string_arena &operator=(const string_arena &) = delete;
+
+			string_arena &operator=(string_arena &&other) noexcept
+			{
+				m_pages = std::move(other.m_pages);
+				m_strings = std::move(other.m_strings);
+				m_page = std::exchange(other.m_page, nullptr);
+				m_page_pos = std::exchange(other.m_page_pos, page_size);
+				return *this;
+			}
+
+			[[nodiscard]] std::string_view intern(std::string_view str)
+			{
+				if (str.empty()) [[unlikely]] return {};
+
+				const auto l = scoped_lock{m_lock};
+				if (const auto pos = m_strings.find(str); pos != m_strings.end())
+					return *pos;
+
+				const auto ptr = allocate(str.size());
+				std::copy_n(str.data(), str.size(), ptr);
+
+				const auto result = std::string_view{ptr, str.size()};
+				m_strings.insert(result);
+				return result;
+			}
+
+		private:
+			char *allocate(std::size_t n)
+			{
+				/* Strings larger than a page are allocated separately, without discarding the current page. */
+				if (n > page_size)
+					return m_pages.emplace_back(std::make_unique<char[]>(n)).get();
+				if (m_page_pos + n > page_size)
+				{
+					m_page = m_pages.emplace_back(std::make_unique<char[]>(page_size)).get();
+					m_page_pos = 0;
+				}
+
+				const auto result = m_page + m_page_pos;
+				m_page_pos += n;
+				return result;
+			}
+
+			std::vector<std::unique_ptr<char[]>> m_pages;
+			tpp::dense_set<std::string_view, type_hash, type_eq> m_strings;
+			char *m_page = nullptr;
+			std::size_t m_page_pos = page_size;
+			shared_spinlock m_lock;
+		};
+
+		/* Immutable minimal perfect hash image of type entries, built when the database is frozen.
+		 * Entries are split into buckets by their name hash, and every bucket is assigned a seed that maps
+		 * all of its entries to distinct unoccupied slots (hash-and-displace). Lookups therefore take exactly one probe. */
+		class type_image
+		{
+		public:
+			/* Builds a perfect hash image of `entries`. Returns `nullptr` if the entries cannot be separated by their hashes. */
+			[[nodiscard]] static std::unique_ptr<type_image> build(std::vector<type_data *> entries);
+
+		public:
+			[[nodiscard]] type_data *find(std::string_view name, std::uint64_t hash) const noexcept
+			{
+				if (m_slots.empty()) [[unlikely]] return nullptr;
+
+				const auto seed = m_seeds[static_cast<std::size_t>(hash % m_seeds.size())];
+				const auto entry = m_slots[slot(hash, seed, m_slots.size())];
+				return entry != nullptr && entry->name_hash == hash && entry->name == name ? entry : nullptr;
+			}
+
+			[[nodiscard]] std::span<type_data *const> entries() const noexcept { return m_entries; }
+
+			/* Overflow entries are inserted after the image was built, and are only reachable through the index. */
+			[[nodiscard]] bool has_overflow() const noexcept { return m_overflow.load(std::memory_order_acquire) != 0; }
+			void add_overflow() noexcept { m_overflow.fetch_add(1, std::memory_order_release); }
+
+		private:
+			[[nodiscard]] static std::size_t slot(std::uint64_t hash, std::uint32_t seed, std::size_t size) noexcept
+			{
+				return static_cast<std::size_t>(hash_mix(hash, seed) % size);
+			}
+
+			[[nodiscard]] bool try_build(std::size_t size);
+
+			std::vector<std::uint32_t> m_seeds;
+			std::vector<type_data *> m_slots;
+			std::vector<type_data *> m_entries;
+			std::atomic<std::size_t> m_overflow = {};
+		};
+
+		/* Independently locked partition of the type database. Types are assigned to shards by their name hash. */
+		struct type_shard : database_lock
+		{
+			/* stable_map is used to allow type_info to be a simple pointer to type_data. Keys reference either static
+			 * storage of compile-time type names, or strings interned in the database. */
+			tpp::stable_map<std::string_view, type_data, type_hash, type_eq> types;
+			/* Lock-free index of entries of `types`, used by `find`. */
+			type_index index;
+		};
+
+		struct database_impl
+		{
+			constexpr static std::size_t shard_count = REFLEX_DATABASE_SHARDS;
+			static_assert(shard_count != 0, "REFLEX_DATABASE_SHARDS must not be 0");
+
 			static auto *local_ptr() noexcept
 			{
 				static database_impl value;
@@ -35,21 +241,225 @@ namespace reflex
 			REFLEX_PUBLIC void reset(std::string_view name);
 
 			REFLEX_PUBLIC type_data *find(std::string_view name);
+			REFLEX_PUBLIC type_data *find(std::string_view name, std::uint64_t hash);
 			REFLEX_PUBLIC REFLEX_COLD type_data *insert(std::string_view name, const constant_type_data &data);
+			REFLEX_PUBLIC REFLEX_COLD void insert_batch(std::span<const constant_type_data *const> data, std::span<type_data *> result);
+			REFLEX_PUBLIC REFLEX_COLD std::vector<std::pair<type_data *, std::chrono::nanoseconds>> prewarm(std::span<const type_handle> types, unsigned threads);
+
+			REFLEX_PUBLIC bool freeze();
+			[[nodiscard]] bool frozen() const noexcept { return m_image.load(std::memory_order_acquire) != nullptr; }
+
+			/* Whole-database operations lock every shard, always in the same order. */
+			void lock() { for (auto &s: m_shards) s.lock(); }
+			void unlock() { for (auto &s: m_shards) s.unlock(); }
+			bool try_lock()
+			{
+				for (std::size_t i = 0; i < shard_count; ++i)
+				{
+					if (m_shards[i].try_lock()) continue;
+					while (i-- != 0) m_shards[i].unlock();
+					return false;
+				}
+				return true;
+			}
+			void lock_shared() const { for (auto &s: m_shards) s.lock_shared(); }
+			void unlock_shared() const { for (auto &s: m_shards) s.unlock_shared(); }
+			bool try_lock_shared() const
+			{
+				for (std::size_t i = 0; i < shard_count; ++i)
+				{
+					if (m_shards[i].try_lock_shared()) continue;
+					while (i-- != 0) m_shards[i].unlock_shared();
+					return false;
+				}
+				return true;
+			}
+
+			/* Invokes `f` on a snapshot of all entries of the database. */
+			template<typename F>
+			void for_each(F &&f)
+			{
+				/* Frozen image is immutable, and can be iterated without locking as long as nothing was inserted since. */
+				if (const auto *image = m_image.load(std::memory_order_acquire); image != nullptr && !image->has_overflow())
+				{
+					for (auto *entry: image->entries()) f(*entry);
+					return;
+				}
 
-			/* stable_map is used to allow type_info to be a simple pointer to type_data. */
-			tpp::stable_map<std::string, type_data, type_hash, type_eq> m_types;
+				/* Entries are copied under the lock, since `f` may need to reflect new types. */
+				std::vector<type_data *> entries;
+				{
+					const auto l = shared_scoped_lock{*this};
+					for (auto &s: m_shards)
+						for (auto &[_, entry]: s.types) entries.push_back(&entry);
+				}
+				for (auto *entry: entries) f(*entry);
+			}
+
+			[[nodiscard]] type_shard &shard(std::uint64_t hash) noexcept { return m_shards[static_cast<std::size_t>(hash >> 32) % shard_count]; }
+			[[nodiscard]] static std::uint64_t key_hash(std::string_view name, const constant_type_data &data) noexcept
+			{
+				/* Entries without a compile-time name hash (i.e. synthetic types) must be hashed at runtime. */
+				return data.name_hash != 0 ? data.name_hash : name_hash(name);
+			}
+
+			/* Inserts an entry without initializing it. Must be called with the shard locked. */
+			std::pair<type_data *, bool> emplace(type_shard &shard, std::string_view name, std::uint64_t hash, const constant_type_data &data);
+			/* Makes a newly inserted entry visible to lock-free readers. Must be called with the shard locked. */
+			void publish(type_shard &shard, type_data &entry);
+			/* Initializes metadata of an inserted or reset entry. Must be called without any shard locked, since type initializers may reflect other types. */
+			void init_entry(type_data &entry);
+			/* Set by prewarm workers, whose entries are initialized outside the database lock. */
+			static bool &defer_init() noexcept;
+			REFLEX_PUBLIC REFLEX_COLD const ancestor_table &build_ancestors(const type_data &data);
+			/* Builds a flattened table of \a data from it's current metadata, which is of table version \a version. */
+			REFLEX_COLD std::unique_ptr<ancestor_table> make_ancestors(const type_data &data, std::uint64_t &version);
+			/* Records that flattened data of \a dependent was built from \a data. Must be called with the ancestor lock held. */
+			static void add_dependent(const type_data &data, const type_data &dependent);
+
+			/* Returns the cast path from type \a from to type \a to cached in the flattened table of \a from, resolving it if needed. */
+			REFLEX_PUBLIC const cast_path &find_cast(type_data &from, const type_data &to);
+			REFLEX_COLD cast_path resolve_cast(type_data &from, const ancestor_table &table, const type_data &to);
+			/* Searches the conversion graph for a chain of at most `REFLEX_CONVERSION_HOPS` conversions from \a from to \a to. */
+			REFLEX_COLD cast_path search_conv(type_data &from, const ancestor_table &table, const type_data &to);
+			REFLEX_PUBLIC static std::uint64_t next_generation() noexcept;
+
+			std::array<type_shard, shard_count> m_shards;
+			string_arena m_names;
+			/* Next dense type ID to be assigned on insertion. */
+			std::atomic<std::uint32_t> m_next_id = {};
+			/* Unique generation of the database, used to validate cached name lookups. Changes when the database is moved from. */
+			std::uint64_t m_generation = next_generation();
+
+			/* Version of the inheritance graph, incremented whenever a flattened ancestor table is dropped. */
+			std::atomic<std::uint64_t> m_graph_version = {1};
+			/* Published ancestor tables are owned by their types. Dropped tables are retired together with the epoch they were
+			 * dropped in, since lock-free readers may still reference them, and are freed by later invalidations once no reader
+			 * has that epoch pinned. Guarded by the ancestor lock. */
+			std::vector<std::pair<std::uint64_t, std::unique_ptr<const ancestor_table>>> m_retired_tables;
+			shared_spinlock m_ancestor_lock;
+
+			/* Perfect hash image of the database, set once it is frozen. Retired images are kept alive for concurrent readers,
+			 * including images dropped when the database is moved from. */
+			std::atomic<type_image *> m_image = {};
+			std::vector<std::unique_ptr<type_image>> m_images;
+		};
+
+		const ancestor_table &type_data::flat_bases(database_impl &db) const
+		{
+			if (const auto table = ancestors.load(std::memory_order_acquire); table != nullptr) [[likely]]
+				return *table;
+			return db.build_ancestors(*this);
+		}
+
+		/* Per-type cache of the type's entry in the most recently used database. Slots are tagged with the generation of the
+		 * owning database, so that entries of replaced or destroyed databases are rejected without being dereferenced. */
+		struct type_slot_t
+		{
+			/* Generation reserved by a thread updating the slot. Never assigned to a database. */
+			constexpr static std::uint64_t busy = std::uint64_t(-1);
+
+			[[nodiscard]] type_data *load(const database_impl *db) const noexcept
+			{
+				if (db == nullptr) return nullptr;
+
+				/* Generation is re-checked after reading the entry, in case the slot was updated for another database in-between. */
+				const auto gen = generation.load(std::memory_order_acquire);
+				if (gen != db->m_generation) return nullptr;
+				const auto result = data.load(std::memory_order_acquire);
+				return generation.load(std::memory_order_relaxed) == gen ? result : nullptr;
+			}
+			void store(const database_impl &db, type_data *entry) noexcept
+			{
+				/* Slot is only a cache, so it is left as-is if another thread is updating it. */
+				auto gen = generation.load(std::memory_order_relaxed);
+				if (gen == busy || !generation.compare_exchange_strong(gen, busy, std::memory_order_acquire))
+					return;
+
+				data.store(entry, std::memory_order_release);
+				generation.store(db.m_generation, std::memory_order_release);
+			}
+
+			std::atomic<std::uint64_t> generation = 0;
+			std::atomic<type_data *> data = nullptr;
 		};
 
 		template<typename T>
-		type_data *data_factory(database_impl &db)
+		inline constinit type_slot_t type_slot = {};
+
+		template<typename T>
+		[[nodiscard]] inline type_data *cached_data(const database_impl *db) noexcept { return type_slot<T>.load(db); }
+
+		template<typename T>
+		[[nodiscard]] const constant_type_data &constant_data()
+		{
+			static const auto value = constant_type_data{std::in_place_type<T>};
+			return value;
+		}
+
+		template<typename T>
+		REFLEX_COLD type_data *insert_data(database_impl &db)
 		{
-			static const auto cdata =  constant_type_data{std::in_place_type<T>};
-			static type_data *data = db.insert(type_name_v<T>, cdata);
+			const auto data = db.insert(type_name_v<T>, constant_data<T>());
+			type_slot<T>.store(db, data);
 			return data;
 		}
+		template<typename... Ts, std::size_t... Is>
+		REFLEX_COLD void insert_data(database_impl &db, std::index_sequence<Is...>)
+		{
+			const auto data = std::array<const constant_type_data *, sizeof...(Ts)>{&constant_data<Ts>()...};
+			auto result = std::array<type_data *, sizeof...(Ts)>{};
+			db.insert_batch(data, result);
+			(type_slot<Ts>.store(db, result[Is]), ...);
+		}
+
+		template<typename T>
+		type_data *data_factory(database_impl &db)
+		{
+			if (const auto data = cached_data<T>(&db); data != nullptr) [[likely]]
+				return data;
+			return insert_data<T>(db);
+		}
 	}
 
+	/** Direct-mapped cache of type name lookups. Lookups of recently resolved names do not access the type database.
+	 * @note Type name cache is not thread-safe and must be synchronized externally. */
+	class type_name_cache
+	{
+		constexpr static std::size_t cache_size = 256;
+
+		struct entry
+		{
+			std::uint64_t generation = 0;
+			std::uint64_t hash = 0;
+			detail::type_data *data = nullptr;
+		};
+
+	public:
+		/** Returns type info for type with name \a name, or an invalid type info if the type has not been reflected yet. */
+		[[nodiscard]] type_info get(std::string_view name)
+		{
+			auto *db = detail::database_impl::instance();
+			const auto hash = detail::name_hash(name);
+
+			/* Cached entries of other (or moved-from) databases are rejected by their generation. */
+			auto &e = m_entries[static_cast<std::size_t>(hash % cache_size)];
+			if (e.generation == db->m_generation && e.hash == hash && e.data->name == name) [[likely]]
+				return {e.data};
+
+			/* Failed lookups are not cached, since the type may be reflected later. */
+			const auto data = db->find(name, hash);
+			if (data != nullptr) e = {db->m_generation, hash, data};
+			return {data};
+		}
+
+		/** Clears all cached lookups. */
+		void clear() noexcept { m_entries = {}; }
+
+	private:
+		std::array<entry, cache_size> m_entries = {};
+	};
+
 	template<typename... Args>
 	argument_list::argument_list(type_pack_t<Args...> p) : argument_list(p, detail::database_impl::instance()) {}
 
@@ -60,16 +470,61 @@ namespace reflex
 		return {detail::data_factory<std::decay_t<T>>, *db};
 	}
 
+	template<typename... Ts>
+	void type_info::reflect_all()
+	{
+		auto *db = detail::database_impl::instance();
+		detail::insert_data<std::decay_t<Ts>...>(*db, std::index_sequence_for<Ts...>{});
+	}
+
 	type_info type_info::get(std::string_view name)
 	{
+#ifdef REFLEX_THREAD_NAME_CACHE
+		thread_local type_name_cache cache;
+		return cache.get(name);
+#else
 		auto *db = detail::database_impl::instance();
-		return {db->find(name), db};
+		return {db->find(name)};
+#endif
 	}
 	template<typename T>
 	type_info type_info::get()
 	{
-		auto *db = detail::database_impl::instance();
-		return {detail::data_factory<std::decay_t<T>>, *db};
+		/* The global pointer is only ever null before the first call to `instance()`, in which case the cache is empty. */
+		auto *db = detail::database_impl::global_ptr().load(std::memory_order_relaxed);
+		if (const auto data = detail::cached_data<std::decay_t<T>>(db); data != nullptr) [[likely]]
+			return {data};
+
+		db = detail::database_impl::instance();
+		return {detail::insert_data<std::decay_t<T>>(*db)};
+	}
+
+	template<typename T>
+	bool type_info::inherits_from() const
+	{
+		/* Use the cached entry of `T` if available, in which case the check is a single ancestry bit test. */
+		if (const auto data = detail::cached_data<std::decay_t<T>>(database()); data != nullptr) [[likely]]
+			return inherits_from(type_info{data});
+		return inherits_from(detail::hashed_type_name_v<std::decay_t<T>>);
+	}
+
+	template<typename T>
+	bool any::is_same() const noexcept
+	{
+		/* Entries are compared directly if `T` is cached for the database of the managed object. Otherwise, fall back to comparing
+		 * names, since IDs of different databases overlap. `T` must not be reflected here, as that would invoke its initializer. */
+		const auto data = type_data();
+		if (data == nullptr) return false;
+		if (const auto cached = detail::cached_data<T>(data->db); cached != nullptr) [[likely]]
+			return cached == data;
+		return data->name_hash == type_hash_v<T> && data->name == type_name_v<T>;
+	}
+	template<typename T>
+	bool any::has_hooks(type_info type) noexcept
+	{
+		if (!type.valid()) return false;
+		const auto &funcs = type.m_data->any_funcs;
+		return funcs.move_init != nullptr && (std::is_trivially_destructible_v<T> || funcs.destroy != nullptr);
 	}
 
 	void type_info::reset(std::string_view name) { detail::database_impl::instance()->reset(name); }
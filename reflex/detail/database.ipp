@@ -4,12 +4,273 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <exception>
+#include <unordered_map>
+
+#ifndef REFLEX_NO_THREADS
+#include <thread>
+#endif
 
 #include "database.hpp"
 
 namespace reflex::detail
 {
+	std::unique_ptr<type_image> type_image::build(std::vector<type_data *> entries)
+	{
+		auto result = std::make_unique<type_image>();
+		result->m_entries = std::move(entries);
+		if (result->m_entries.empty()) return result;
+
+		/* Entries with identical hashes can never be separated by a seed. */
+		auto hashes = std::vector<std::uint64_t>(result->m_entries.size());
+		std::ranges::transform(result->m_entries, hashes.begin(), [](auto *e) { return e->name_hash; });
+		std::ranges::sort(hashes);
+		if (std::ranges::adjacent_find(hashes) != hashes.end())
+			[[unlikely]] return nullptr;
+
+		/* Start with a minimal table, and add slack whenever a bucket cannot be placed. */
+		for (auto size = result->m_entries.size(); !result->try_build(size);)
+			size += size / 8 + 1;
+		return result;
+	}
+	bool type_image::try_build(std::size_t size)
+	{
+		/* Use ~4 entries per bucket, and place larger buckets first while the table is still sparse. */
+		auto buckets = std::vector<std::vector<type_data *>>(std::max<std::size_t>(1, m_entries.size() / 4));
+		for (auto *entry: m_entries) buckets[entry->name_hash % buckets.size()].push_back(entry);
+
+		auto order = std::vector<std::size_t>(buckets.size());
+		for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+		std::ranges::stable_sort(order, std::greater<>{}, [&](auto i) { return buckets[i].size(); });
+
+		m_seeds.assign(buckets.size(), 0);
+		m_slots.assign(size, nullptr);
+
+		constexpr std::uint32_t max_seed = 1 << 16;
+		std::vector<std::size_t> placed;
+		for (auto i: order)
+		{
+			if (buckets[i].empty()) break;
+
+			for (std::uint32_t seed = 0;; ++seed)
+			{
+				if (seed == max_seed) return false;
+
+				/* All entries of the bucket must land in distinct unoccupied slots. */
+				placed.clear();
+				for (auto *entry: buckets[i])
+				{
+					const auto pos = slot(entry->name_hash, seed, size);
+					if (m_slots[pos] != nullptr || std::ranges::find(placed, pos) != placed.end())
+						break;
+					placed.push_back(pos);
+				}
+				if (placed.size() != buckets[i].size())
+					continue;
+
+				for (std::size_t j = 0; j < placed.size(); ++j)
+					m_slots[placed[j]] = buckets[i][j];
+				m_seeds[i] = seed;
+				break;
+			}
+		}
+		return true;
+	}
+
+	type_data::init_thread &type_data::this_init_thread() noexcept
+	{
+		thread_local init_thread value;
+		return value;
+	}
+	bool type_data::init_by_this_thread() const noexcept
+	{
+		for (auto frame = this_init_thread().top; frame != nullptr; frame = frame->prev)
+			if (frame->data == this) return true;
+		return false;
+	}
+	bool type_data::wait_init(init_thread &thread, std::uint8_t state) const
+	{
+		/* Threads that do not initialize any entry cannot be part of a cycle. */
+		if (thread.top == nullptr)
+		{
+			init_state.wait(state, std::memory_order_acquire);
+			return true;
+		}
+
+		/* Edges of the wait graph are only modified with the graph lock held, so that the last thread to close a cycle observes it. */
+		static std::atomic_flag graph_lock;
+		const auto lock = []() { while (graph_lock.test_and_set(std::memory_order_acquire)) graph_lock.wait(true, std::memory_order_relaxed); };
+		const auto unlock = []() { graph_lock.clear(std::memory_order_release); graph_lock.notify_one(); };
+
+		lock();
+		for (auto owner = init_owner.load(std::memory_order_acquire); owner != nullptr; owner = owner->waiting->init_owner.load(std::memory_order_acquire))
+		{
+			if (owner == &thread)
+			{
+				unlock();
+				return false;
+			}
+			if (owner->waiting == nullptr)
+				break;
+		}
+		thread.waiting = this;
+		unlock();
+
+		init_state.wait(state, std::memory_order_acquire);
+
+		lock();
+		thread.waiting = nullptr;
+		unlock();
+		return true;
+	}
+
+	type_data &type_data::reset()
+	{
+		/* Initializer running on this thread continues with the cleared metadata. */
+		auto &thread = this_init_thread();
+		if (init_by_this_thread())
+		{
+			dynamic_type_data::clear();
+			return *this;
+		}
+
+		/* Entry is claimed while being cleared, so that concurrent users wait for it instead of initializing it. */
+		for (auto state = init_state.load(std::memory_order_acquire);;)
+		{
+			if (state != init_running && init_state.compare_exchange_weak(state, init_running, std::memory_order_acquire))
+				break;
+			if (state == init_running)
+			{
+				/* Same applies to initializers running on threads that wait for this thread. */
+				if (!wait_init(thread, state))
+				{
+					dynamic_type_data::clear();
+					return *this;
+				}
+				state = init_state.load(std::memory_order_acquire);
+			}
+		}
+
+		dynamic_type_data::clear();
+		init_state.store(init_pending, std::memory_order_release);
+		init_state.notify_all();
+		return *this;
+	}
+
+	void type_data::deferred_init(database_impl &db)
+	{
+		auto &thread = this_init_thread();
+		if (init_by_this_thread()) return;
+
+		/* Only one thread initializes the entry, others wait for it to finish. */
+		for (auto state = init_state.load(std::memory_order_acquire); state != init_done; state = init_state.load(std::memory_order_acquire))
+		{
+			if (state == init_running)
+			{
+				/* Initialization is cyclic across threads. Same as for re-entrant initialization, the entry is used as-is. */
+				if (!wait_init(thread, state)) return;
+				continue;
+			}
+			if (!init_state.compare_exchange_weak(state, init_running, std::memory_order_acquire))
+				continue;
+
+			init_owner.store(&thread, std::memory_order_release);
+			const auto frame = init_thread::frame{this, thread.top};
+			thread.top = &frame;
+			try { init(db); }
+			catch (...)
+			{
+				/* Let the next user retry initialization. */
+				thread.top = frame.prev;
+				init_owner.store(nullptr, std::memory_order_relaxed);
+				init_state.store(init_pending, std::memory_order_release);
+				init_state.notify_all();
+				throw;
+			}
+			thread.top = frame.prev;
+			init_owner.store(nullptr, std::memory_order_relaxed);
+			init_state.store(init_done, std::memory_order_release);
+			init_state.notify_all();
+			return;
+		}
+	}
+
+	struct table_epoch::record
+	{
+		/* Epoch pinned by the owning thread, or 0 if the thread is not reading tables. */
+		std::atomic<std::uint64_t> pinned = 0;
+		/* Records are never freed, and are reused once their thread exits. */
+		std::atomic<bool> in_use = true;
+		record *next = nullptr;
+		std::size_t depth = 0;
+	};
+
+	std::atomic<std::uint64_t> &table_epoch::epoch() noexcept
+	{
+		static std::atomic<std::uint64_t> value = 1;
+		return value;
+	}
+	std::atomic<table_epoch::record *> &table_epoch::records() noexcept
+	{
+		static std::atomic<record *> value = nullptr;
+		return value;
+	}
+	table_epoch::record &table_epoch::this_record()
+	{
+		struct handle_t
+		{
+			handle_t() : ptr(acquire()) {}
+			~handle_t() { ptr->in_use.store(false, std::memory_order_release); }
+
+			static record *acquire()
+			{
+				for (auto rec = records().load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+					if (auto expected = false; rec->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+						return rec;
+
+				const auto rec = new record{};
+				rec->next = records().load(std::memory_order_relaxed);
+				while (!records().compare_exchange_weak(rec->next, rec, std::memory_order_release, std::memory_order_relaxed));
+				return rec;
+			}
+
+			record *ptr;
+		};
+		thread_local handle_t handle;
+		return *handle.ptr;
+	}
+
+	void table_epoch::pin()
+	{
+		auto &rec = this_record();
+		if (rec.depth++ != 0) return;
+
+		/* Pin must be visible to reclaiming threads before any table is loaded. Pairs with the fence in `oldest`. */
+		rec.pinned.store(epoch().load(std::memory_order_acquire), std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+	}
+	void table_epoch::unpin() noexcept
+	{
+		if (auto &rec = this_record(); --rec.depth == 0)
+			rec.pinned.store(0, std::memory_order_release);
+	}
+	std::uint64_t table_epoch::retire() noexcept
+	{
+		return epoch().fetch_add(1, std::memory_order_acq_rel);
+	}
+	std::uint64_t table_epoch::oldest() noexcept
+	{
+		/* Readers that loaded a dropped table have pinned an epoch that is visible after this fence. */
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto result = epoch().load(std::memory_order_acquire);
+		for (auto rec = records().load(std::memory_order_acquire); rec != nullptr; rec = rec->next)
+			if (const auto pinned = rec->pinned.load(std::memory_order_acquire); pinned != 0)
+				result = std::min(result, pinned);
+		return result;
+	}
+
 	database_impl *database_impl::instance() noexcept
 	{
 		for (auto ptr = global_ptr().load();;)
@@ -32,39 +293,482 @@ namespace reflex::detail
 	database_impl::database_impl(database_impl &&other)
 	{
 		const auto l = detail::scoped_lock{other};
-		std::construct_at(&m_types, std::move(other.m_types));
+		for (std::size_t i = 0; i < shard_count; ++i)
+		{
+			auto &shard = m_shards[i];
+			std::construct_at(&shard.types, std::move(other.m_shards[i].types));
+			for (auto &[_, entry]: shard.types)
+			{
+				entry.db = this;
+				shard.index.insert(&entry);
+			}
+			other.m_shards[i].index.retire();
+		}
+		m_names = std::move(other.m_names);
+		m_next_id = other.m_next_id.exchange(0);
+		other.m_generation = next_generation();
+
+		/* Published ancestor tables are owned by the moved entries. Retired tables may still be referenced by readers of them. */
+		m_retired_tables = std::move(other.m_retired_tables);
+		m_graph_version = other.m_graph_version.fetch_add(1);
+
+		/* Frozen state is not transferred, the entries no longer belong to `other` either way. Lock-free lookups may still
+		 * probe the retired index tables & images of `other`, so these are kept alive until `other` is destroyed. */
+		other.m_image.store(nullptr, std::memory_order_release);
+	}
+	database_impl::~database_impl()
+	{
+		for (auto &s: m_shards)
+			for (auto &[_, entry]: s.types) delete entry.ancestors.load(std::memory_order_relaxed);
 	}
-	database_impl::~database_impl() = default;
 
 	void database_impl::reset()
 	{
-		const auto l = detail::scoped_lock{*this};
-		for (auto &[_, entry]: m_types) reset(entry);
+		/* Entries are reset without the database locked, since resetting waits for initializers that may reflect other types. */
+		std::vector<type_data *> entries;
+		{
+			const auto l = detail::shared_scoped_lock{*this};
+			for (auto &s: m_shards)
+				for (auto &[_, entry]: s.types) entries.push_back(&entry);
+		}
+		for (auto *entry: entries) reset(*entry);
+		for (auto *entry: entries) init_entry(*entry);
+	}
+	void database_impl::reset(type_data &data)
+	{
+		data.reset();
+		invalidate_tables(*this, data);
 	}
-	void database_impl::reset(type_data &data) { data.reset(*this); }
 	void database_impl::reset(std::string_view name)
 	{
-		const auto l = detail::scoped_lock{*this};
-		if (auto iter = m_types.find(name); iter != m_types.end())
-			[[likely]] reset(iter->second);
+		auto &s = shard(name_hash(name));
+		type_data *entry = nullptr;
+		{
+			const auto l = detail::shared_scoped_lock{s};
+			if (auto iter = s.types.find(name); iter != s.types.end())
+				[[likely]] entry = &iter->second;
+		}
+		if (entry != nullptr)
+		{
+			reset(*entry);
+			init_entry(*entry);
+		}
 	}
 
-	type_data *database_impl::find(std::string_view name)
+	type_data *database_impl::find(std::string_view name) { return find(name, name_hash(name)); }
+	type_data *database_impl::find(std::string_view name, std::uint64_t hash)
 	{
-		const auto l = detail::shared_scoped_lock{*this};
-		if (const auto iter = m_types.find(name); iter != m_types.end())
-			return &iter->second;
-		else
-			return nullptr;
+		/* Frozen databases are looked up through the perfect hash image. Types inserted after freezing are reachable through the index. */
+		if (const auto *image = m_image.load(std::memory_order_acquire); image != nullptr)
+		{
+			if (const auto entry = image->find(name, hash); entry != nullptr || !image->has_overflow())
+				return entry;
+		}
+
+		/* Readers do not need to lock the database, since the index is only ever appended to. */
+		return shard(hash).index.find(name, hash);
 	}
 	type_data *database_impl::insert(std::string_view name, const constant_type_data &data)
+	{
+		/* Only the shard of the type is locked, so that types of different shards can be inserted concurrently. */
+		const auto hash = key_hash(name, data);
+		auto &s = shard(hash);
+
+		auto result = std::pair<type_data *, bool>{};
+		{
+			const auto l = detail::scoped_lock{s};
+			if ((result = emplace(s, name, hash, data)).second)
+				publish(s, *result.first);
+		}
+		/* Initializers may reflect types of other shards, so the entry is initialized after the shard lock is released. */
+		if (result.second) init_entry(*result.first);
+		return result.first;
+	}
+	void database_impl::insert_batch(std::span<const constant_type_data *const> data, std::span<type_data *> result)
+	{
+		assert(data.size() == result.size());
+		std::vector<type_data *> inserted;
+		inserted.reserve(data.size());
+		{
+			/* Shards are locked in the same order as by other whole-database operations, and no other shard is locked while they are held. */
+			const auto l = detail::scoped_lock{*this};
+
+			auto shard_sizes = std::array<std::size_t, shard_count>{};
+			for (auto *cdata: data) ++shard_sizes[static_cast<std::size_t>(&shard(key_hash(cdata->name, *cdata)) - m_shards.data())];
+			for (std::size_t i = 0; i < shard_count; ++i)
+				m_shards[i].types.reserve(m_shards[i].types.size() + shard_sizes[i]);
+
+			/* Insert all entries before initializing any of them, so that initialization of one entry finds the rest of the batch. */
+			for (std::size_t i = 0; i < data.size(); ++i)
+			{
+				const auto hash = key_hash(data[i]->name, *data[i]);
+				auto &s = shard(hash);
+
+				const auto [entry, is_new] = emplace(s, data[i]->name, hash, *data[i]);
+				if (is_new)
+				{
+					publish(s, *entry);
+					inserted.push_back(entry);
+				}
+				result[i] = entry;
+			}
+		}
+		for (auto *entry: inserted) init_entry(*entry);
+	}
+
+	std::pair<type_data *, bool> database_impl::emplace(type_shard &shard, std::string_view name, std::uint64_t hash, const constant_type_data &data)
+	{
+		if (const auto iter = shard.types.find(name); iter != shard.types.end())
+			return {&iter->second, false};
+
+		/* Compile-time type names reference static storage and do not need to be copied. Other names are interned. */
+		const auto key = name.data() == data.name.data() ? name : m_names.intern(name);
+		auto &entry = shard.types.emplace(key, data).first->second;
+		entry.name = key;
+		entry.name_hash = hash;
+		entry.id = m_next_id.fetch_add(1, std::memory_order_relaxed);
+		entry.db = this;
+		return {&entry, true};
+	}
+	void database_impl::publish(type_shard &shard, type_data &entry)
+	{
+		/* Entries are published before being initialized. Readers initialize them on first use of their metadata. */
+		shard.index.insert(&entry);
+		if (const auto image = m_image.load(std::memory_order_relaxed); image != nullptr)
+			image->add_overflow();
+	}
+	void database_impl::init_entry([[maybe_unused]] type_data &entry)
+	{
+#ifndef REFLEX_LAZY_INIT
+		/* Entries are initialized on insertion, unless initialization was deferred by the inserting thread. */
+		if (!defer_init()) entry.init_once(*this);
+#endif
+	}
+
+	std::string_view intern_name(database_impl &db, std::string_view str) { return db.m_names.intern(str); }
+
+	const ancestor_table &database_impl::build_ancestors(const type_data &data)
+	{
+		/* Only published tables can be reclaimed, so tables built from metadata that changed in the meantime are rebuilt. */
+		for (;;)
+		{
+			auto version = std::uint64_t{};
+			auto table = make_ancestors(data, version);
+
+			/* Tables are only published while none is, so that a published table is only dropped by invalidation. If another
+			 * thread has already published a table, it was built from the current metadata and the new one is discarded. */
+			const auto l = scoped_lock{m_ancestor_lock};
+			if (const auto current = data.ancestors.load(std::memory_order_acquire); current != nullptr)
+				return *current;
+			if (data.table_version == version)
+			{
+				data.ancestors.store(table.get(), std::memory_order_release);
+				return *table.release();
+			}
+		}
+	}
+	std::unique_ptr<ancestor_table> database_impl::make_ancestors(const type_data &data, std::uint64_t &version)
+	{
+		/* Bases are resolved up-front, since resolving a base may reflect and initialize it. */
+		auto bases = std::vector<std::pair<type_data *, base_step>>{};
+		for (auto &[_, base]: data.bases)
+			bases.emplace_back(&base.type(*this)->init_once(*this), base.cast);
+
+		/* The type is registered as a dependent of its bases before reading them, so that changes made in-between drop the new table. */
+		{
+			const auto l = scoped_lock{m_ancestor_lock};
+			version = data.table_version;
+			for (auto &[base, _]: bases) add_dependent(*base, data);
+		}
+
+		auto table = std::make_unique<ancestor_table>();
+
+		const auto make_ancestor = [](type_data *type, base_step step)
+		{
+			auto result = type_ancestor{type, 0, {}};
+			if (step.func == nullptr)
+				result.offset = step.offset;
+			else
+				result.path.push_back(step);
+			return result;
+		};
+
+		/* Immediate bases are added first, so that the shortest cast path to an ancestor is preferred. */
+		for (auto &[base, step]: bases)
+			table->entries.try_emplace(base->name, make_ancestor(base, step));
+		for (auto &[base, step]: bases)
+		{
+			for (auto &[name, ancestor]: base->flat_bases(*this).entries)
+			{
+				if (table->entries.find(name) != table->entries.end())
+					continue;
+
+				/* Fixed offsets are summed when the base cast is not virtual, otherwise the ancestor's cast is appended to the path. */
+				auto result = make_ancestor(ancestor.type, step);
+				if (result.path.empty())
+					result.offset += ancestor.offset;
+				else if (ancestor.offset != 0)
+					result.path.emplace_back(ancestor.offset);
+				result.path.insert(result.path.end(), ancestor.path.begin(), ancestor.path.end());
+				table->entries.try_emplace(name, std::move(result));
+			}
+		}
+
+		const auto add_names = [&](const type_data &type)
+		{
+			for (auto &[name, _]: type.convs) table->names.insert(name_filter::conv_name, name_hash(name));
+			for (auto &[name, _]: type.vtabs) table->names.insert(name_filter::vtab_name, name_hash(name));
+		};
+		add_names(data);
+
+		for (auto &[name, ancestor]: table->entries)
+		{
+			table->names.insert(name_filter::base_name, name_hash(name));
+			add_names(*ancestor.type);
+
+			const auto id = ancestor.type->id;
+			if (id / 64 >= table->mask.size()) table->mask.resize(id / 64 + 1);
+			table->mask[id / 64] |= std::uint64_t{1} << (id % 64);
+		}
+
+		/* Facets of the type itself are added first, followed by those of ancestors from nearest to farthest. */
+		auto groups = std::vector<std::pair<std::string_view, const std::vector<std::string_view> *>>{};
+		const auto add_vtabs = [&](const type_data &type)
+		{
+			for (auto &[name, vtab]: type.vtabs)
+				table->vtabs.try_emplace(name, vtab);
+			for (auto &[name, members]: type.vtab_groups)
+				if (table->vtab_groups.try_emplace(name).second) groups.emplace_back(name, &members);
+		};
+		add_vtabs(data);
+		for (auto &[_, ancestor]: table->entries)
+			add_vtabs(*ancestor.type);
+
+		/* Groups are resolved from the flattened vtables, so that facets overridden by a descendant are picked up by inherited groups. */
+		for (auto &[name, members]: groups)
+		{
+			auto &vtabs = table->vtab_groups.find(name)->second;
+			vtabs.reserve(members->size());
+			for (auto &member: *members)
+				vtabs.push_back(table->vtabs.find(member)->second);
+		}
+
+		return table;
+	}
+	void database_impl::add_dependent(const type_data &data, const type_data &dependent)
+	{
+		if (std::ranges::find(data.dependents, &dependent) == data.dependents.end())
+			data.dependents.push_back(&dependent);
+	}
+	void invalidate_tables(database_impl &db, const type_data &data)
+	{
+		/* Tables of dependents are dropped as well, since they were built from the changed metadata. Dependents are
+		 * re-registered once their tables are rebuilt, so the list is cleared, which also terminates any cycles. */
+		const auto l = scoped_lock{db.m_ancestor_lock};
+		auto dropped = std::vector<const ancestor_table *>{};
+		auto pending = std::vector<const type_data *>{&data};
+		while (!pending.empty())
+		{
+			const auto type = pending.back();
+			pending.pop_back();
+
+			++type->table_version;
+			if (const auto table = type->ancestors.exchange(nullptr, std::memory_order_acq_rel); table != nullptr)
+				dropped.push_back(table);
+			pending.insert(pending.end(), type->dependents.begin(), type->dependents.end());
+			type->dependents.clear();
+		}
+		if (!dropped.empty())
+		{
+			db.m_graph_version.fetch_add(1, std::memory_order_acq_rel);
+			const auto epoch = table_epoch::retire();
+			for (auto *table: dropped) db.m_retired_tables.emplace_back(epoch, table);
+		}
+
+		/* Tables retired before the oldest pinned epoch can no longer be referenced by any reader. */
+		if (!db.m_retired_tables.empty())
+			std::erase_if(db.m_retired_tables, [oldest = table_epoch::oldest()](auto &entry) { return entry.first < oldest; });
+	}
+
+	const cast_path &database_impl::find_cast(type_data &from, const type_data &to)
+	{
+		/* Paths are cached in the table they were resolved from, so that they are dropped together with it. */
+		const auto &table = from.init_once(*this).flat_bases(*this);
+		if (const auto path = table.casts.find(&to); path != nullptr) [[likely]]
+			return *path;
+		return table.casts.insert(&to, resolve_cast(from, table, to));
+	}
+	cast_path database_impl::resolve_cast(type_data &from, const ancestor_table &table, const type_data &to)
+	{
+		if (&from == &to) return {cast_kind::identity};
+
+		if (const auto pos = table.entries.find(to.name); pos != table.entries.end())
+			return {cast_kind::base, &pos->second};
+		if (const auto pos = from.convs.find(to.name); pos != from.convs.end())
+			return {cast_kind::conv, nullptr, pos->second.func};
+
+		/* Ancestors are visited in order of their distance, so that the closest conversion is preferred. */
+		for (auto &[_, ancestor]: table.entries)
+		{
+			if (const auto pos = ancestor.type->convs.find(to.name); pos != ancestor.type->convs.end())
+				return {cast_kind::base_conv, &ancestor, pos->second.func};
+		}
+		return REFLEX_CONVERSION_HOPS > 1 ? search_conv(from, table, to) : cast_path{};
+	}
+	cast_path database_impl::search_conv(type_data &from, const ancestor_table &table, const type_data &to)
+	{
+		/* Edges reference conversions of the searched types, which are only copied into the resulting chain. */
+		struct edge_t
+		{
+			const type_ancestor *ancestor;
+			const type_conv *conv;
+		};
+		/* Paths are ranked by the number of lossy conversions first, and by the number of hops second. */
+		struct node
+		{
+			std::size_t lossy;
+			type_data *prev;
+			edge_t edge;
+		};
+		std::unordered_map<const type_data *, node> nodes;
+		nodes.try_emplace(&from, node{0, nullptr, {}});
+
+		/* Conversion graph is relaxed one hop at a time, so that every chain is bounded by the hop limit. */
+		std::vector<type_data *> frontier = {&from}, next;
+		for (std::size_t hop = 0; hop < REFLEX_CONVERSION_HOPS && !frontier.empty(); ++hop, frontier.swap(next))
+		{
+			next.clear();
+			for (auto *type: frontier)
+			{
+				const auto &data = type->init_once(*this);
+				const auto lossy = nodes.at(type).lossy;
+				const auto relax = [&](std::string_view name, edge_t edge)
+				{
+					const auto target = edge.conv->type ? edge.conv->type(*this) : find(name);
+					if (target == nullptr || target == &from) return;
+
+					const auto cost = lossy + !edge.conv->lossless;
+					const auto [pos, inserted] = nodes.try_emplace(target, node{cost, type, edge});
+					if (!inserted)
+					{
+						if (pos->second.lossy <= cost) return;
+						pos->second = node{cost, type, edge};
+					}
+					if (target != &to) next.push_back(target);
+				};
+
+				/* The result is cached in the table of `from`, which must be dropped once any of the searched types change.
+				 * The dependency is registered before reading conversions of the type, so that changes made in-between are not missed. */
+				if (type != &from)
+				{
+					const auto l = scoped_lock{m_ancestor_lock};
+					add_dependent(data, from);
+				}
+
+				const auto &entries = type != &from ? data.flat_bases(*this).entries : table.entries;
+				for (auto &[name, conv]: data.convs)
+					relax(name, {nullptr, &conv});
+				for (auto &[_, ancestor]: entries)
+					for (auto &[name, conv]: ancestor.type->convs)
+						relax(name, {&ancestor, &conv});
+			}
+		}
+
+		const auto pos = nodes.find(&to);
+		if (pos == nodes.end()) return {};
+
+		auto chain = std::make_unique<conv_chain>();
+		for (auto iter = pos; iter->second.prev != nullptr; iter = nodes.find(iter->second.prev))
+		{
+			const auto &edge = iter->second.edge;
+			chain->hops.push_back({edge.ancestor != nullptr ? cast_kind::base_conv : cast_kind::conv, edge.ancestor, edge.conv->func});
+		}
+		std::ranges::reverse(chain->hops);
+		return {cast_kind::chain, nullptr, {}, std::move(chain)};
+	}
+
+	std::uint64_t database_impl::next_generation() noexcept
+	{
+		/* Generation 0 is never used, so that empty cache entries never match. */
+		static std::atomic<std::uint64_t> value = {1};
+		return value.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool &database_impl::defer_init() noexcept
+	{
+		thread_local bool value = false;
+		return value;
+	}
+
+	std::vector<std::pair<type_data *, std::chrono::nanoseconds>> database_impl::prewarm(std::span<const type_handle> types, [[maybe_unused]] unsigned threads)
+	{
+		auto result = std::vector<std::pair<type_data *, std::chrono::nanoseconds>>(types.size());
+		auto error = std::exception_ptr{};
+		auto failed = std::atomic<bool>{};
+		auto next = std::atomic<std::size_t>{};
+
+		const auto worker = [&]()
+		{
+			struct defer_guard
+			{
+				defer_guard() noexcept { defer_init() = true; }
+				~defer_guard() { defer_init() = false; }
+			};
+
+			for (std::size_t i; !failed.load(std::memory_order_relaxed) && (i = next.fetch_add(1, std::memory_order_relaxed)) < types.size();)
+			{
+				try
+				{
+					/* Insert the entry without initializing it, so that initialization does not hold the database lock. */
+					type_data *entry;
+					{
+						const auto g = defer_guard{};
+						entry = types[i](*this);
+					}
+
+					const auto start = std::chrono::steady_clock::now();
+					entry->init_once(*this);
+					result[i] = {entry, std::chrono::steady_clock::now() - start};
+				}
+				catch (...)
+				{
+					if (!failed.exchange(true)) error = std::current_exception();
+				}
+			}
+		};
+
+#ifndef REFLEX_NO_THREADS
+		if (threads == 0) threads = std::max(std::thread::hardware_concurrency(), 1u);
+		threads = static_cast<unsigned>(std::min<std::size_t>(threads, types.size()));
+
+		/* The calling thread is used as one of the workers. */
+		std::vector<std::thread> workers;
+		for (unsigned i = 1; i < threads; ++i)
+			workers.emplace_back(worker);
+		worker();
+		for (auto &t: workers) t.join();
+#else
+		worker();
+#endif
+
+		if (error) std::rethrow_exception(error);
+		return result;
+	}
+
+	bool database_impl::freeze()
 	{
 		const auto l = detail::scoped_lock{*this};
 
-		/* Type name must be copied into the database, and the entry must be post-initialized. */
-		auto &[name_str, entry] = *m_types.emplace(name, data).first;
-		entry.name = name_str;
-		entry.init(*this);
-		return &entry;
+		std::vector<type_data *> entries;
+		for (auto &s: m_shards)
+			for (auto &[_, entry]: s.types) entries.push_back(&entry);
+
+		/* Image may fail to build only in case of a full 64-bit hash collision, in which case the database stays as-is. */
+		auto image = type_image::build(std::move(entries));
+		if (image == nullptr) [[unlikely]] return false;
+
+		/* Readers of the previous image may still be in-flight. */
+		m_image.store(m_images.emplace_back(std::move(image)).get(), std::memory_order_release);
+		return true;
 	}
 }
\ No newline at end of file
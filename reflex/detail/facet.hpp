@@ -236,9 +236,12 @@ namespace reflex
 	void type_factory<>::add_facet(const std::tuple<const Vs *...> &vt)
 	{
 		(m_data->vtabs.emplace_or_replace(type_name_v<Vs>, std::get<const Vs *>(vt)), ...);
+		if constexpr (sizeof...(Vs) > 1)
+			m_data->vtab_groups.emplace_or_replace(type_name_v<std::tuple<const Vs *...>>, std::vector<std::string_view>{type_name_v<Vs>...});
+		detail::invalidate_tables(*m_db, *m_data);
 	}
 
-	template<typename F>
+	template<typename F> requires (!instance_of<F, facets::facet_group>)
 	type_factory<> &type_factory<>::implement_facet(const typename F::vtable_type &vtab)
 	{
 		add_facet(std::make_tuple(&vtab));
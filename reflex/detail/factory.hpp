@@ -17,7 +17,7 @@ namespace reflex
 		friend class type_factory;
 		friend class type_info;
 
-		type_factory(detail::type_handle handle, detail::database_impl &db) : m_data(handle(db)), m_db(&db) {}
+		type_factory(detail::type_handle handle, detail::database_impl &db) : m_data(&handle(db)->init_once(db)), m_db(&db) {}
 		constexpr type_factory(detail::type_data *data, detail::database_impl *db) noexcept : m_data(data), m_db(db) {}
 
 	public:
@@ -29,7 +29,7 @@ namespace reflex
 		constexpr type_factory &operator=(type_factory &&) noexcept = default;
 
 		/** Returns the underlying type initialized by this type factory. */
-		[[nodiscard]] constexpr type_info type() const noexcept { return {m_data, m_db}; }
+		[[nodiscard]] constexpr type_info type() const noexcept { return {m_data}; }
 
 		/** Adds an attribute initialized from \a value to the underlying type info. */
 		type_factory &attribute(const any &value)
@@ -47,28 +47,31 @@ namespace reflex
 		/** Adds an enumeration constant named \a name initialized from \a value to the underlying type info. */
 		type_factory &enumerate(std::string_view name, const any &value)
 		{
-			m_data->enums.emplace_or_replace(name, value);
+			m_data->enums.emplace_or_replace(detail::intern_name(*m_db, name), value);
 			return *this;
 		}
 		/** @copydoc enumerate. */
 		type_factory &enumerate(std::string_view name, any &&value)
 		{
-			m_data->enums.emplace_or_replace(name, std::forward<any>(value));
+			m_data->enums.emplace_or_replace(detail::intern_name(*m_db, name), std::forward<any>(value));
 			return *this;
 		}
 
 		/** Adds a parent of type \a type to the list of bases of the underlying type info.
-		 * Dynamic casts from child type to parent type will be preformed using \a cast.  */
+		 * Dynamic casts from child type to parent type will be preformed using \a cast, which must be convertible to a function pointer.  */
 		template<typename F>
-		type_factory &add_parent(type_info type, F &&cast) requires std::is_invocable_r_v<const void *, F, const void *>
+		type_factory &add_parent(type_info type, F &&cast) requires std::convertible_to<F, detail::base_cast>
 		{
-			m_data->bases.emplace_or_replace(type.name(), [n = type.name()](auto &db) { return detail::data_factory(n, db); }, std::forward<F>(cast));
+			/* Synthetic parents are resolved by name only if the type is used with another database. */
+			const auto handle = [n = type.name()](auto &db) { return db.find(n); };
+			m_data->bases.emplace_or_replace(type.name(), detail::type_base{{handle, type.m_data}, detail::base_step{static_cast<detail::base_cast>(cast)}});
+			detail::invalidate_tables(*m_db, *m_data);
 			return *this;
 		}
 
 		/** Implements facet \a F for the underlying type info using facet vtable \a vtab.
 		 * @param vtab Reference to facet vtable for facet \a F. */
-		template<typename F>
+		template<typename F> requires (!instance_of<F, facets::facet_group>)
 		inline type_factory &implement_facet(const typename F::vtable_type &vtab);
 		/** Implements all facets in facet group \a G for the underlying type info using group vtable \a vtab.
 		 * @param vtab Tuple of vtables of the individual facet types in facet group \a G. */
@@ -98,6 +101,7 @@ namespace reflex
 		type_factory &make_convertible(type_info type, F &&conv) requires std::is_invocable_r_v<any, F, const void *>
 		{
 			m_data->convs.emplace_or_replace(type.name(), std::forward<F>(conv));
+			detail::invalidate_tables(*m_db, *m_data);
 			return *this;
 		}
 		
@@ -109,7 +113,7 @@ namespace reflex
 		void add_ctor(F &&func)
 		{
 			const auto args = std::array{detail::make_arg_data<Ts>()...};
-			if (auto existing = m_data->find_exact_ctor(args); existing == nullptr)
+			if (auto existing = m_data->find_exact_ctor(args, *m_db); existing == nullptr)
 				m_data->ctors.emplace_back(type_pack<Ts...>, std::forward<F>(func));
 			else
 				*existing = detail::type_ctor{type_pack<Ts...>, std::forward<F>(func)};
@@ -117,7 +121,7 @@ namespace reflex
 		template<typename F>
 		void add_ctor(std::span<const detail::arg_data> args, F &&func)
 		{
-			if (auto existing = m_data->find_exact_ctor(args); existing == nullptr)
+			if (auto existing = m_data->find_exact_ctor(args, *m_db); existing == nullptr)
 				m_data->ctors.emplace_back(args, std::forward<F>(func));
 			else
 				*existing = detail::type_ctor{args, std::forward<F>(func)};
@@ -158,7 +162,7 @@ namespace reflex
 		template<typename... Args>
 		type_factory &enumerate(std::string_view name, Args &&...args) requires std::constructible_from<T, Args...>
 		{
-			m_data->enums.emplace_or_replace(name, type(), std::in_place_type<T>, std::forward<Args>(args)...);
+			m_data->enums.emplace_or_replace(detail::intern_name(*m_db, name), type(), std::in_place_type<T>, std::forward<Args>(args)...);
 			return *this;
 		}
 		/** Adds enumeration constant named \a name initialized from \a Value to the underlying type info. */
@@ -170,6 +174,7 @@ namespace reflex
 		type_factory &add_parent() requires std::derived_from<T, U>
 		{
 			m_data->bases.emplace_or_replace(type_name_v<U>, detail::make_type_base<T, U>());
+			detail::invalidate_tables(*m_db, *m_data);
 			return *this;
 		}
 
@@ -189,7 +194,7 @@ namespace reflex
 		type_factory &make_constructible() requires std::constructible_from<T, Args...>
 		{
 			const auto args = std::array{detail::make_arg_data<Args>()...};
-			if (auto existing = m_data->find_exact_ctor(args); existing == nullptr)
+			if (auto existing = m_data->find_exact_ctor(args, *m_db); existing == nullptr)
 				m_data->ctors.emplace_back(detail::make_type_ctor<T, Args...>());
 			else
 				*existing = detail::make_type_ctor<T, Args...>();
@@ -205,6 +210,7 @@ namespace reflex
 			{
 				return forward_any(std::invoke(f, *static_cast<const T *>(p)));
 			});
+			detail::invalidate_tables(*m_db, *m_data);
 			return *this;
 		}
 		/** Makes the underlying type info convertible to type \a U using conversion functor \a conv.
@@ -213,6 +219,7 @@ namespace reflex
 		type_factory &make_convertible(F &&conv) requires (std::same_as<std::decay_t<U>, U> && std::is_invocable_r_v<U, F, const T &>)
 		{
 			m_data->convs.emplace_or_replace(type_name_v<U>, detail::make_type_conv<T, U>(std::forward<F>(conv)));
+			detail::invalidate_tables(*m_db, *m_data);
 			return *this;
 		}
 		/** Makes the underlying type info convertible to \a U using `static_cast<U>(value)`.
@@ -221,6 +228,7 @@ namespace reflex
 		type_factory &make_convertible() requires (std::same_as<std::decay_t<U>, U> && std::convertible_to<T, U>)
 		{
 			m_data->convs.emplace_or_replace(type_name_v<U>, detail::make_type_conv<T, U>());
+			detail::invalidate_tables(*m_db, *m_data);
 			return *this;
 		}
 
@@ -31,6 +31,7 @@ namespace reflex
 	class bad_any_cast;
 
 	class type_database;
+	class type_name_cache;
 
 	namespace detail { struct synthetic; }
 
@@ -49,15 +50,33 @@ namespace reflex
 	class type_info;
 	class object;
 	class any;
+	template<std::size_t N, std::size_t A = alignof(std::max_align_t)>
+	class basic_any;
 
 	namespace detail
 	{
+		/* Name with a pre-computed hash. Compile-time type names carry `type_hash_v` to avoid re-hashing on every lookup. */
+		struct hashed_name
+		{
+			constexpr hashed_name(std::string_view value) noexcept : hashed_name(value, name_hash(value)) {}
+			constexpr hashed_name(std::string_view value, std::uint64_t hash) noexcept : value(value), hash(hash) {}
+
+			std::string_view value;
+			std::uint64_t hash;
+		};
+
+		template<typename T>
+		inline constexpr auto hashed_type_name_v = hashed_name{type_name_v<T>, type_hash_v<T>};
+
+		/* All name-keyed tables must use `name_hash`, so that lookups via `hashed_name` are consistent with string keys. */
 		struct type_hash
 		{
 			using is_transparent = std::true_type;
 
-			[[nodiscard]] std::size_t operator()(const std::string &value) const { return tpp::seahash_hash<std::string>{}(value); }
-			[[nodiscard]] std::size_t operator()(const std::string_view &value) const { return tpp::seahash_hash<std::string_view>{}(value); }
+			[[nodiscard]] std::size_t operator()(const std::string &value) const { return static_cast<std::size_t>(name_hash(value)); }
+			[[nodiscard]] std::size_t operator()(const std::string_view &value) const { return static_cast<std::size_t>(name_hash(value)); }
+			[[nodiscard]] std::size_t operator()(const hashed_name &value) const { return static_cast<std::size_t>(value.hash); }
+			/* Type infos are hashed by their dense ID, not by name. */
 			[[nodiscard]] inline std::size_t operator()(const type_info &value) const;
 		};
 		struct type_eq
@@ -68,12 +87,12 @@ namespace reflex
 			[[nodiscard]] bool operator()(const std::string_view &a, const std::string_view &b) const { return a == b; }
 			[[nodiscard]] bool operator()(const std::string &a, const std::string_view &b) const { return std::string_view{a} == b; }
 			[[nodiscard]] bool operator()(const std::string_view &a, const std::string &b) const { return a == std::string_view{b}; }
+			[[nodiscard]] bool operator()(const hashed_name &a, const std::string &b) const { return a.value == std::string_view{b}; }
+			[[nodiscard]] bool operator()(const std::string &a, const hashed_name &b) const { return std::string_view{a} == b.value; }
+			[[nodiscard]] bool operator()(const hashed_name &a, const std::string_view &b) const { return a.value == b; }
+			[[nodiscard]] bool operator()(const std::string_view &a, const hashed_name &b) const { return a == b.value; }
 
 			[[nodiscard]] inline bool operator()(const type_info &a, const type_info &b) const;
-			[[nodiscard]] inline bool operator()(const std::string &a, const type_info &b) const;
-			[[nodiscard]] inline bool operator()(const type_info &a, const std::string &b) const;
-			[[nodiscard]] inline bool operator()(const type_info &a, const std::string_view &b) const;
-			[[nodiscard]] inline bool operator()(const std::string_view &a, const type_info &b) const;
 		};
 
 		using type_set = tpp::dense_set<type_info, detail::type_hash, detail::type_eq>;
@@ -88,19 +107,21 @@ namespace reflex
 
 			/* Used by any */
 			is_owned = 0x4,
-			any_flags_max = 0x7,
+			is_inline = 0x8,
+			is_nontrivial = 0x10,
+			any_flags_max = 0x1f,
 
 			/* Used by type_data */
-			is_null = 0x8,
-			is_void = 0x10,
-			is_enum = 0x20,
-			is_class = 0x40,
-			is_pointer = 0x80,
-			is_abstract = 0x100,
-
-			is_signed_int = 0x200,
-			is_unsigned_int = 0x400,
-			is_arithmetic = 0x800,
+			is_null = 0x20,
+			is_void = 0x40,
+			is_enum = 0x80,
+			is_class = 0x100,
+			is_pointer = 0x200,
+			is_abstract = 0x400,
+
+			is_signed_int = 0x800,
+			is_unsigned_int = 0x1000,
+			is_arithmetic = 0x2000,
 		};
 
 		constexpr type_flags operator~(const type_flags &x) noexcept { return static_cast<type_flags>(~static_cast<std::underlying_type_t<type_flags>>(x)); }
@@ -118,9 +139,10 @@ namespace reflex
 		struct type_ctor;
 		struct type_conv;
 		struct type_data;
+		class object_cast_cache;
 
 		using type_handle = delegate<type_data *(database_impl &)>;
-		using base_cast = const void *(*)(const void *) noexcept;
+		using base_cast = const void *(*)(const void *);
 
 		template<typename T>
 		[[nodiscard]] constexpr static any_funcs_t make_any_funcs() noexcept;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "fwd.hpp"
@@ -116,7 +117,7 @@ namespace reflex
 		/** Returns type of the argument. */
 		[[nodiscard]] inline type_info type() const noexcept;
 
-		[[nodiscard]] constexpr bool operator==(const argument_info &other) const noexcept;
+		[[nodiscard]] inline bool operator==(const argument_info &other) const;
 
 	private:
 		const detail::arg_data *m_data;
@@ -128,7 +129,7 @@ namespace reflex
 	{
 		friend class type_info;
 
-		constexpr constructor_view(const std::list<detail::type_ctor> *list, detail::database_impl *db) : m_view(list), m_db(db) {}
+		constexpr constructor_view(const detail::type_data *type) : m_type(type) {}
 
 	public:
 		using value_type = constructor_info;
@@ -146,9 +147,9 @@ namespace reflex
 		constructor_view &operator=(constructor_view &&) noexcept = default;
 
 		/** Checks if the constructor list is empty. */
-		[[nodiscard]] bool empty() const noexcept { return m_view->empty(); }
+		[[nodiscard]] inline bool empty() const noexcept;
 		/** Returns total amount of constructors in the constructor list. */
-		[[nodiscard]] size_type size() const noexcept { return m_view->size(); }
+		[[nodiscard]] inline size_type size() const noexcept;
 
 		/** Returns iterator to the first argument of the list. */
 		[[nodiscard]] inline iterator begin() const noexcept;
@@ -160,8 +161,8 @@ namespace reflex
 		[[nodiscard]] inline iterator cend() const noexcept;
 
 	private:
-		const std::list<detail::type_ctor> *m_view = nullptr;
-		detail::database_impl *m_db = nullptr;
+		/* Constructors & database are reached via the owning type entry. */
+		const detail::type_data *m_type = nullptr;
 	};
 	/** Structure representing constructor of a reflected type. */
 	class constructor_info
@@ -212,7 +213,11 @@ namespace reflex
 
 		friend class argument_list;
 		friend class argument_info;
+		friend class type_database;
+		friend class type_name_cache;
 		friend class any;
+		friend class detail::object_cast_cache;
+		friend struct detail::arg_data;
 
 	public:
 		/** Returns type query used to filter reflected types. */
@@ -222,6 +227,10 @@ namespace reflex
 		 * @note Modifications of type info made through the type factory are not thread-safe and must be synchronized externally. */
 		template<typename T>
 		inline static type_factory<T> reflect();
+		/** Reflects type info for all types \a Ts at once. Equivalent to calling `reflect<T>()` for every type of \a Ts,
+		 * but locks the type database only once for the entire batch. Useful for registering large sets of types on startup. */
+		template<typename... Ts>
+		inline static void reflect_all();
 
 		/** Returns type info for type with name \a name, or an invalid type info if the type has not been reflected yet. */
 		[[nodiscard]] inline static type_info get(std::string_view name);
@@ -238,8 +247,17 @@ namespace reflex
 		inline static void reset();
 
 	private:
-		type_info(detail::type_handle handle, detail::database_impl &db) : m_data(handle(db)), m_db(&db) {}
-		constexpr type_info(detail::type_data *data, detail::database_impl *db) noexcept : m_data(data), m_db(db) {}
+		type_info(detail::type_handle handle, detail::database_impl &db) : m_data(handle(db)) {}
+
+		/* Returns type data with initialized dynamic metadata. */
+		[[nodiscard]] inline detail::type_data *dynamic_data() const;
+		/* Returns the database owning the referenced entry. */
+		[[nodiscard]] inline detail::database_impl *database() const noexcept;
+		constexpr type_info(detail::type_data *data) noexcept : m_data(data) {}
+
+	public:
+		/** ID returned by `id()` for an invalid type info. */
+		static constexpr std::uint32_t invalid_id = static_cast<std::uint32_t>(-1);
 
 	public:
 		/** Initializes an invalid type info. */
@@ -252,6 +270,9 @@ namespace reflex
 
 		/** Returns the name of the referenced type. */
 		[[nodiscard]] constexpr std::string_view name() const noexcept;
+		/** Returns the dense integer ID of the referenced type, or `invalid_id` if the type info is invalid.
+		 * @note Type IDs are unique within a type database and are assigned in order of registration. */
+		[[nodiscard]] constexpr std::uint32_t id() const noexcept;
 
 		/** Returns the size of the referenced type.
 		 * @note If `is_empty_v<T>` evaluates to `true` for referenced type \a T, returns `0` instead of `1`. */
@@ -299,11 +320,13 @@ namespace reflex
 		/** Returns the extent of the referenced type. */
 		[[nodiscard]] constexpr std::size_t extent() const noexcept;
 
-		/** Checks if the referenced type has an attribute of type \a T. */
+		/** Checks if the referenced type has an attribute of type \a T.
+		 * @throw Any exception thrown by the type's initializer, if metadata of the referenced type is initialized by this call. */
 		template<typename T>
-		[[nodiscard]] bool has_attribute() const noexcept { return has_attribute(type_name_v<std::decay_t<T>>); }
-		/** Checks if the referenced type has an attribute of type \a type. */
-		[[nodiscard]] bool has_attribute(type_info type) const noexcept { return type.valid() && has_attribute(type.name()); }
+		[[nodiscard]] bool has_attribute() const { return has_attribute(detail::hashed_type_name_v<std::decay_t<T>>); }
+		/** Checks if the referenced type has an attribute of type \a type.
+		 * @throw Any exception thrown by the type's initializer, if metadata of the referenced type is initialized by this call. */
+		[[nodiscard]] bool has_attribute(type_info type) const { return type.valid() && has_attribute(type.name_key()); }
 
 		/** Returns a map of the referenced type's attributes. */
 		[[nodiscard]] REFLEX_PUBLIC detail::attr_map attributes() const;
@@ -315,11 +338,12 @@ namespace reflex
 
 		/** Checks if the referenced type has an enumeration with value \a value. */
 		template<typename T>
-		[[nodiscard]] inline bool has_enumeration(T &&value) const requires (!std::same_as<std::decay_t<T>, any>);
+		[[nodiscard]] inline bool has_enumeration(T &&value) const requires (!std::derived_from<std::decay_t<T>, any>);
 		/** @copydoc has_enumeration */
 		[[nodiscard]] REFLEX_PUBLIC bool has_enumeration(const any &value) const;
-		/** Checks if the referenced type has an enumeration with name \a name. */
-		[[nodiscard]] REFLEX_PUBLIC bool has_enumeration(std::string_view name) const noexcept;
+		/** Checks if the referenced type has an enumeration with name \a name.
+		 * @throw Any exception thrown by the type's initializer, if metadata of the referenced type is initialized by this call. */
+		[[nodiscard]] REFLEX_PUBLIC bool has_enumeration(std::string_view name) const;
 
 		/** Returns a map of the referenced type's enumerations. */
 		[[nodiscard]] REFLEX_PUBLIC detail::enum_map enumerations() const;
@@ -333,7 +357,7 @@ namespace reflex
 		[[nodiscard]] inline bool implements_facet() const;
 		/** Checks if the referenced type implements a facet type \a F. */
 		template<typename F>
-		[[nodiscard]] inline bool implements_facet() const { return implements_facet(type_name_v<typename F::vtable_type>); }
+		[[nodiscard]] inline bool implements_facet() const { return implements_facet(detail::hashed_type_name_v<typename F::vtable_type>); }
 
 		/** Returns facet group of type \a G for object instance \a obj. */
 		template<instance_of<facets::facet_group> G>
@@ -350,9 +374,9 @@ namespace reflex
 
 		/** Checks if the referenced type inherits from a base type \a T. */
 		template<typename T>
-		[[nodiscard]] bool inherits_from() const { return inherits_from(type_name_v<std::decay_t<T>>); }
+		[[nodiscard]] inline bool inherits_from() const;
 		/** Checks if the referenced type inherits from a base type \a type. */
-		[[nodiscard]] bool inherits_from(type_info type) const { return type.valid() && inherits_from(type.name()); }
+		[[nodiscard]] REFLEX_PUBLIC bool inherits_from(type_info type) const;
 
 		/** Returns a set of the referenced type's parents (including the parents' parents). */
 		[[nodiscard]] REFLEX_PUBLIC detail::type_set parents() const;
@@ -365,8 +389,9 @@ namespace reflex
 		/** @copydoc constructible_from */
 		[[nodiscard]] REFLEX_PUBLIC bool constructible_from(std::span<any> args) const;
 
-		/** Returns a view of the referenced type's constructors. */
-		[[nodiscard]] constexpr constructor_view constructors() const noexcept;
+		/** Returns a view of the referenced type's constructors.
+		 * @throw Any exception thrown by the type's initializer, if metadata of the referenced type is initialized by this call. */
+		[[nodiscard]] inline constructor_view constructors() const;
 		/** Constructs an object of the referenced type from arguments \a args.
 		 * @return `any` containing the constructed object instance, or an empty `any` if `this` is not valid or the referenced type is not constructible from \a args. */
 		template<typename... Args>
@@ -379,9 +404,9 @@ namespace reflex
 
 		/** Checks if the referenced type is convertible to type \a T, or inherits from a type convertible to \a T. */
 		template<typename T>
-		[[nodiscard]] bool convertible_to() const { return convertible_to(type_name_v<std::decay_t<T>>); }
+		[[nodiscard]] bool convertible_to() const { return convertible_to(detail::hashed_type_name_v<std::decay_t<T>>); }
 		/** Checks if the referenced type is convertible to type \a type, or inherits from a type convertible to \a type. */
-		[[nodiscard]] bool convertible_to(type_info type) const { return type.valid() && convertible_to(type.name()); }
+		[[nodiscard]] bool convertible_to(type_info type) const { return type.valid() && convertible_to(type.name_key()); }
 
 		/** Checks if the referenced type is same as, inherits from, or can be type-cast to type \a T. */
 		template<typename T>
@@ -396,13 +421,16 @@ namespace reflex
 		/* Convenience operator for access to underlying type_data. */
 		[[nodiscard]] constexpr detail::type_data *operator->() const noexcept { return m_data; }
 
-		[[nodiscard]] REFLEX_PUBLIC bool has_attribute(std::string_view) const noexcept;
+		/* Name of the referenced type with it's pre-computed hash. */
+		[[nodiscard]] constexpr detail::hashed_name name_key() const noexcept;
 
-		[[nodiscard]] REFLEX_PUBLIC bool implements_facet(std::string_view) const;
-		[[nodiscard]] REFLEX_PUBLIC bool inherits_from(std::string_view) const;
+		[[nodiscard]] REFLEX_PUBLIC bool has_attribute(detail::hashed_name) const;
+
+		[[nodiscard]] REFLEX_PUBLIC bool implements_facet(detail::hashed_name) const;
+		[[nodiscard]] REFLEX_PUBLIC bool inherits_from(detail::hashed_name) const;
 
 		[[nodiscard]] REFLEX_PUBLIC bool constructible_from(std::span<const detail::arg_data>) const;
-		[[nodiscard]] REFLEX_PUBLIC bool convertible_to(std::string_view) const;
+		[[nodiscard]] REFLEX_PUBLIC bool convertible_to(detail::hashed_name) const;
 
 		[[nodiscard]] REFLEX_PUBLIC bool comparable_with(std::string_view) const noexcept;
 		[[nodiscard]] REFLEX_PUBLIC bool eq_comparable_with(std::string_view) const noexcept;
@@ -411,17 +439,23 @@ namespace reflex
 		[[nodiscard]] REFLEX_PUBLIC bool gt_comparable_with(std::string_view) const noexcept;
 		[[nodiscard]] REFLEX_PUBLIC bool lt_comparable_with(std::string_view) const noexcept;
 
-		[[nodiscard]] REFLEX_PUBLIC const void *get_vtab(std::string_view) const;
+		[[nodiscard]] REFLEX_PUBLIC const void *get_vtab(detail::hashed_name) const;
 
 		template<typename T>
-		[[nodiscard]] auto get_vtab() const { return static_cast<const typename T::vtable_type *>(get_vtab(type_name_v<typename T::vtable_type>)); }
-		template<typename... Ts>
-		[[nodiscard]] auto get_vtab(type_pack_t<Ts...>) const { return std::forward_as_tuple(get_vtab<Ts>()...); }
+		[[nodiscard]] auto get_vtab() const { return static_cast<const typename T::vtable_type *>(get_vtab(detail::hashed_type_name_v<typename T::vtable_type>)); }
+		[[nodiscard]] REFLEX_PUBLIC bool get_vtab_group(detail::hashed_name, std::span<const void *> vtabs) const;
 
-		inline void fill_parents(detail::type_set &result) const;
+		template<typename... Ts>
+		[[nodiscard]] auto get_vtab(type_pack_t<Ts...>) const
+		{
+			using group_t = std::tuple<const typename Ts::vtable_type *...>;
+			if (auto group = std::array<const void *, sizeof...(Ts)>{}; get_vtab_group(detail::hashed_type_name_v<group_t>, group))
+				return [&]<std::size_t... Is>(std::index_sequence<Is...>) { return group_t{static_cast<const typename Ts::vtable_type *>(group[Is])...}; }(std::index_sequence_for<Ts...>{});
+			return group_t{get_vtab<Ts>()...};
+		}
 
+		/* Entries know their owning database, so the type info is a single pointer. */
 		detail::type_data *m_data = nullptr;
-		detail::database_impl *m_db = nullptr;
 	};
 
 	[[nodiscard]] constexpr bool operator==(const type_info &a, const std::string_view &b) noexcept { return a.name() == b; }
@@ -441,6 +475,6 @@ namespace reflex
 }
 
 template<auto F>
-struct tpp::hash<reflex::type_info, F> { std::size_t operator()(const reflex::type_info &value) const { return tpp::hash<std::string_view, F>{}(value.name()); }};
+struct tpp::hash<reflex::type_info, F> { std::size_t operator()(const reflex::type_info &value) const { return std::hash<std::uint32_t>{}(value.id()); }};
 template<>
-struct std::hash<reflex::type_info> { std::size_t operator()(const reflex::type_info &value) const { return std::hash<std::string_view>{}(value.name()); }};
+struct std::hash<reflex::type_info> { std::size_t operator()(const reflex::type_info &value) const { return std::hash<std::uint32_t>{}(value.id()); }};
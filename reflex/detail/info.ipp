@@ -23,29 +23,32 @@ namespace reflex
 	{
 		if (!valid()) [[unlikely]] return {};
 
-		auto result = detail::attr_map{m_data->attrs.size()};
-		for (const auto &[_, value]: m_data->attrs)
+		const auto data = dynamic_data();
+		auto result = detail::attr_map{data->attrs.size()};
+		for (const auto &[_, value]: data->attrs)
 			result.emplace(value.type(), value.ref());
 		return result;
 	}
 	any type_info::attribute(std::string_view name) const
 	{
 		if (!valid()) [[unlikely]] return {};
-		const auto pos = m_data->attrs.find(name);
-		return pos != m_data->attrs.end() ? pos->second.ref() : any{};
+		const auto data = dynamic_data();
+		const auto pos = data->attrs.find(name);
+		return pos != data->attrs.end() ? pos->second.ref() : any{};
 	}
-	bool type_info::has_attribute(std::string_view name) const noexcept
+	bool type_info::has_attribute(detail::hashed_name name) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_attr(name);
+		return dynamic_data()->find_attr(name);
 	}
 
 	detail::enum_map type_info::enumerations() const
 	{
 		if (!valid()) [[unlikely]] return {};
 
-		auto result = detail::enum_map{m_data->enums.size()};
-		for (const auto &[name, value]: m_data->enums)
+		const auto data = dynamic_data();
+		auto result = detail::enum_map{data->enums.size()};
+		for (const auto &[name, value]: data->enums)
 			result.emplace(name, value.ref());
 		return result;
 	}
@@ -53,43 +56,63 @@ namespace reflex
 	{
 		if (!valid()) [[unlikely]] return {};
 
-		const auto pos = m_data->enums.find(name);
-		return pos != m_data->enums.end() ? pos->second.ref() : any{};
+		const auto data = dynamic_data();
+		const auto pos = data->enums.find(name);
+		return pos != data->enums.end() ? pos->second.ref() : any{};
 	}
 	bool type_info::has_enumeration(const any &value) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_enum(value);
+		return dynamic_data()->find_enum(value);
 	}
-	bool type_info::has_enumeration(std::string_view name) const noexcept
+	bool type_info::has_enumeration(std::string_view name) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_enum(name);
+		return dynamic_data()->find_enum(name);
 	}
 
 	detail::type_set type_info::parents() const
 	{
-		detail::type_set result;
-		fill_parents(result);
+		if (!valid()) [[unlikely]] return {};
+
+		const auto guard = detail::table_guard{};
+		const auto &table = dynamic_data()->flat_bases(*database()).entries;
+		auto result = detail::type_set{};
+		result.reserve(table.size());
+		for (auto &[_, ancestor]: table) result.emplace(type_info{ancestor.type});
 		return result;
 	}
-	bool type_info::inherits_from(std::string_view name) const
+	bool type_info::inherits_from(type_info type) const
+	{
+		if (!valid() || !type.valid()) [[unlikely]] return false;
+
+		/* Type IDs are only unique within a single database. */
+		if (type.database() == database()) [[likely]]
+		{
+			const auto guard = detail::table_guard{};
+			return dynamic_data()->flat_bases(*database()).contains(type.m_data->id);
+		}
+		return inherits_from(type.name_key());
+	}
+	bool type_info::inherits_from(detail::hashed_name name) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_base(name, *m_db);
+
+		const auto guard = detail::table_guard{};
+		return dynamic_data()->find_base(name, *database());
 	}
 
-	bool type_info::implements_facet(std::string_view name) const
+	bool type_info::implements_facet(detail::hashed_name name) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_vtab(name, *m_db);
+		return dynamic_data()->find_vtab(name, *database());
 	}
 
 	any type_info::construct(std::span<any> args) const
 	{
 		if (valid()) [[likely]]
 		{
-			const auto *ctor = m_data->find_ctor(args, *m_db);
+			const auto *ctor = dynamic_data()->find_ctor(args, *database());
 			if (ctor) return (*ctor)(args);
 		}
 		return {};
@@ -98,37 +121,33 @@ namespace reflex
 	bool type_info::constructible_from(std::span<const detail::arg_data> args) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_ctor(args, *m_db);
+		return dynamic_data()->find_ctor(args, *database());
 	}
 	bool type_info::constructible_from(std::span<any> args) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_ctor(args, *m_db);
+		return dynamic_data()->find_ctor(args, *database());
 	}
 
-	bool type_info::convertible_to(std::string_view name) const
+	bool type_info::convertible_to(detail::hashed_name name) const
 	{
 		if (!valid()) [[unlikely]] return false;
-		return m_data->find_conv(name, *m_db);
+		return dynamic_data()->find_conv(name, *database());
 	}
 
-	void type_info::fill_parents(detail::type_set &result) const
+	const void *type_info::get_vtab(detail::hashed_name name) const
 	{
-		if (valid()) [[likely]]
-		{
-			/* Recursively add parent types to the set. */
-			result.reserve(result.capacity() + m_data->bases.size());
-			for (auto [_, base]: m_data->bases)
-			{
-				const auto parent = type_info{base.type, *m_db};
-				parent.fill_parents(result);
-				result.emplace(parent);
-			}
-		}
+		if (!valid()) [[unlikely]] return nullptr;
+		return dynamic_data()->find_vtab(name, *database());
 	}
-	const void *type_info::get_vtab(std::string_view name) const
+	bool type_info::get_vtab_group(detail::hashed_name name, std::span<const void *> vtabs) const
 	{
-		if (!valid()) [[unlikely]] return nullptr;
-		return m_data->find_vtab(name, *m_db);
+		if (!valid()) [[unlikely]] return false;
+
+		/* Vtables are copied out of the flattened table, since it may be freed once the guard is released. */
+		const auto guard = detail::table_guard{};
+		const auto group = dynamic_data()->find_vtab_group(name, *database());
+		if (group != nullptr) std::copy_n(group, vtabs.size(), vtabs.begin());
+		return group != nullptr;
 	}
-}
\ No newline at end of file
+}
@@ -37,6 +37,75 @@ namespace reflex
 	template<typename T>
 	[[nodiscard]] type_info type_of(T &&obj) requires std::derived_from<std::decay_t<T>, object> { return static_cast<const object &>(obj).do_type_of(); }
 
+	namespace detail
+	{
+		/* Polymorphic inline cache of `object_cast` results, keyed by the dynamic type entry. Entries store the type entry
+		 * pointer tagged with the cast result, and are only valid for the database generation & graph version of the cache.
+		 * Cache is guarded by a sequence lock, so that readers never observe entries of a different database or graph version. */
+		class object_cast_cache
+		{
+			constexpr static std::size_t size = 4;
+
+		public:
+			/* Checks if `from` is the same as or inherits from `to`. */
+			[[nodiscard]] bool is_a(type_info from, type_info to)
+			{
+				const auto *db = from.database();
+				const auto version = db->m_graph_version.load(std::memory_order_acquire);
+				const auto key = reinterpret_cast<std::uintptr_t>(from.m_data);
+
+				/* Sequence is odd while a writer is updating the cache. */
+				if (const auto seq = m_seq.load(std::memory_order_acquire); !(seq & 1)) [[likely]]
+				{
+					auto value = std::uintptr_t{};
+					if (m_generation.load(std::memory_order_relaxed) == db->m_generation && m_version.load(std::memory_order_relaxed) == version)
+						for (auto &entry: m_entries)
+							if (const auto e = entry.load(std::memory_order_relaxed); (e & ~std::uintptr_t{1}) == key) value = e;
+
+					std::atomic_thread_fence(std::memory_order_acquire);
+					if (value != 0 && m_seq.load(std::memory_order_relaxed) == seq)
+						return value & 1;
+				}
+				return is_a_slow(from, to, db->m_generation, version, key);
+			}
+
+		private:
+			REFLEX_COLD bool is_a_slow(type_info from, type_info to, std::uint64_t generation, std::uint64_t version, std::uintptr_t key)
+			{
+				const auto result = from == to || from.inherits_from(to);
+
+				/* Cache is only updated if no other writer is active, as it may always be re-filled on the next call. */
+				auto seq = m_seq.load(std::memory_order_relaxed);
+				if ((seq & 1) || !m_seq.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed))
+					return result;
+				std::atomic_thread_fence(std::memory_order_release);
+
+				/* Entries of a different database or graph version are cleared before the new generation & version are published. */
+				if (m_generation.load(std::memory_order_relaxed) != generation || m_version.load(std::memory_order_relaxed) != version)
+				{
+					for (auto &entry: m_entries) entry.store(0, std::memory_order_relaxed);
+					m_generation.store(generation, std::memory_order_relaxed);
+					m_version.store(version, std::memory_order_relaxed);
+				}
+
+				/* Entries are replaced in round-robin order. */
+				m_entries[m_next++ % size].store(key | result, std::memory_order_relaxed);
+				m_seq.store(seq + 2, std::memory_order_release);
+				return result;
+			}
+
+			std::atomic<std::uint64_t> m_seq = {};
+			std::atomic<std::uint64_t> m_generation = {};
+			std::atomic<std::uint64_t> m_version = {};
+			std::array<std::atomic<std::uintptr_t>, size> m_entries = {};
+			/* Only accessed by the writer holding the sequence lock. */
+			std::size_t m_next = 0;
+		};
+
+		template<typename To, typename From>
+		inline constinit object_cast_cache object_cast_cache_v;
+	}
+
 	/** @brief Dynamically casts an object of type \a From to type \a To.
 	 *
 	 * If \a From is a child of \a To, returns `static_cast<To *>(ptr)`.
@@ -57,9 +126,8 @@ namespace reflex
 			return static_cast<To *>(ptr);
 		else if constexpr (std::derived_from<From, object> && std::derived_from<To, object>)
 		{
-			const auto from_type = type_of(*ptr);
-			const auto to_type = type_info::get<To>();
-			if (from_type == to_type || from_type.inherits_from(to_type))
+			/* Every instantiation has its own cache, since the result only depends on the dynamic type of the object. */
+			if (detail::object_cast_cache_v<std::remove_cv_t<To>, std::remove_cv_t<From>>.is_a(type_of(*ptr), type_info::get<To>()))
 			{
 				auto *obj = static_cast<take_const_t<object, From> *>(ptr);
 				return static_cast<To *>(const_cast<object *>(obj));
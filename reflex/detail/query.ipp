@@ -14,8 +14,7 @@ namespace reflex
 	detail::type_set type_query<>::types() const
 	{
 		detail::type_set result;
-		for (auto &[_, type]: m_db->m_types)
-			result.insert(type_info{&type, m_db});
+		m_db->for_each([&](detail::type_data &type) { result.insert(type_info{&type}); });
 		return result;
 	}
 	template<>
@@ -25,11 +24,11 @@ namespace reflex
 		detail::type_set result;
 
 		/* Fill the set with initial elements. */
-		for (auto &[_, type]: m_db->m_types)
+		m_db->for_each([&](detail::type_data &type)
 		{
-			if (filters[0](this, type_info{&type, m_db}))
-				result.insert({&type, m_db});
-		}
+			if (filters[0](this, type_info{&type}))
+				result.insert(type_info{&type});
+		});
 
 		/* Filter bad elements from the set. */
 		for (std::size_t i = 1; !result.empty() && i < filters.size(); ++i)
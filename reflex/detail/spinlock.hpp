@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <array>
 #include <tuple>
 
 #include "define.hpp"
@@ -57,6 +58,50 @@ namespace reflex::detail
 #endif
 	};
 
+#ifndef REFLEX_NO_THREADS
+	/* Writer-preferring reader-writer lock with distributed reader indicators. Every thread is assigned one of
+	 * `slot_count` cache line-sized reader slots, so that concurrent readers do not contend on a single counter.
+	 * Writers announce themselves before draining the reader slots, which stops new readers from entering.
+	 * Both readers & writers park on the respective atomic (futex on supported platforms) after spinning. */
+	class scalable_shared_lock
+	{
+		constexpr static std::size_t spin_max = 12;
+		constexpr static std::size_t slot_count = 64;
+
+		struct alignas(64) reader_slot
+		{
+			std::atomic<std::uint32_t> value = {};
+		};
+
+	public:
+		REFLEX_PUBLIC void lock();
+		REFLEX_PUBLIC void unlock();
+		REFLEX_PUBLIC bool try_lock();
+
+		REFLEX_PUBLIC void lock_shared() const;
+		REFLEX_PUBLIC void unlock_shared() const;
+		REFLEX_PUBLIC bool try_lock_shared() const;
+
+	private:
+		[[nodiscard]] static std::size_t thread_slot() noexcept;
+
+		[[nodiscard]] bool try_enter(std::atomic<std::uint32_t> &slot) const;
+		void drain_readers() const;
+
+		mutable std::array<reader_slot, slot_count> m_readers = {};
+		alignas(64) mutable std::atomic<std::uint32_t> m_writer = {};
+	};
+
+	/* Lock used to synchronize the type database. */
+#ifdef REFLEX_SCALABLE_LOCK
+	using database_lock = scalable_shared_lock;
+#else
+	using database_lock = shared_spinlock;
+#endif
+#else
+	using database_lock = shared_spinlock;
+#endif
+
 	/* Custom implementation of scoped_lock + shared_scoped_lock to avoid including mutex & shared_mutex */
 
 	template<typename... Ts>
@@ -54,5 +54,96 @@ namespace reflex::detail
 		m_reader_ctr++;
 		return true;
 	}
+
+	std::size_t scalable_shared_lock::thread_slot() noexcept
+	{
+		/* Threads are assigned reader slots round-robin, which keeps slots unique as long as there are less than `slot_count` threads. */
+		static std::atomic<std::size_t> next_slot = {};
+		thread_local const auto slot = next_slot.fetch_add(1, std::memory_order_relaxed) % slot_count;
+		return slot;
+	}
+
+	bool scalable_shared_lock::try_enter(std::atomic<std::uint32_t> &slot) const
+	{
+		if (m_writer.load(std::memory_order_relaxed) != 0)
+			return false;
+
+		/* Writer may have started draining after the check, in which case back off to give it priority. */
+		slot.fetch_add(1, std::memory_order_seq_cst);
+		if (m_writer.load(std::memory_order_seq_cst) == 0) [[likely]]
+			return true;
+
+		if (slot.fetch_sub(1, std::memory_order_seq_cst) == 1)
+			slot.notify_all();
+		return false;
+	}
+	void scalable_shared_lock::drain_readers() const
+	{
+		for (auto &slot: m_readers)
+		{
+			for (std::size_t i = 0;; ++i)
+			{
+				const auto n = slot.value.load(std::memory_order_seq_cst);
+				if (n == 0) break;
+				if (i >= spin_max) slot.value.wait(n, std::memory_order_seq_cst);
+			}
+		}
+	}
+
+	void scalable_shared_lock::lock()
+	{
+		for (std::size_t i = 0;; ++i)
+		{
+			auto expected = std::uint32_t{};
+			if (m_writer.compare_exchange_weak(expected, 1, std::memory_order_seq_cst))
+				break;
+			if (i >= spin_max && expected != 0)
+				m_writer.wait(expected, std::memory_order_relaxed);
+		}
+		drain_readers();
+	}
+	void scalable_shared_lock::unlock()
+	{
+		m_writer.store(0, std::memory_order_release);
+		m_writer.notify_all();
+	}
+	bool scalable_shared_lock::try_lock()
+	{
+		auto expected = std::uint32_t{};
+		if (!m_writer.compare_exchange_strong(expected, 1, std::memory_order_seq_cst))
+			return false;
+
+		for (auto &slot: m_readers)
+		{
+			if (slot.value.load(std::memory_order_seq_cst) != 0)
+			{
+				unlock();
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void scalable_shared_lock::lock_shared() const
+	{
+		auto &slot = m_readers[thread_slot()].value;
+		for (std::size_t i = 0; !try_enter(slot); ++i)
+		{
+			if (i < spin_max) continue;
+			if (const auto writer = m_writer.load(std::memory_order_relaxed); writer != 0)
+				m_writer.wait(writer, std::memory_order_relaxed);
+		}
+	}
+	void scalable_shared_lock::unlock_shared() const
+	{
+		/* Wake up a writer draining the slot. */
+		auto &slot = m_readers[thread_slot()].value;
+		if (slot.fetch_sub(1, std::memory_order_seq_cst) == 1 && m_writer.load(std::memory_order_seq_cst) != 0)
+			slot.notify_all();
+	}
+	bool scalable_shared_lock::try_lock_shared() const
+	{
+		return try_enter(m_readers[thread_slot()].value);
+	}
 #endif
 }
\ No newline at end of file
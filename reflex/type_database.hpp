@@ -25,6 +25,60 @@ namespace reflex
 		 * in turn potentially leading to unintended runtime bugs. */
 		static type_database *instance(type_database *ptr) noexcept { return impl_cast(impl_t::instance(impl_cast(ptr))); }
 
+		/** Inserts types described by \a data into the database under a single lock acquisition.
+		 * Types already present in the database are left as-is. Names of \a data are expected to reference static storage
+		 * (such as `type_name_v`), and are not copied into the database.
+		 * @return Vector of type infos of the inserted types, in the same order as \a data. */
+		std::vector<type_info> insert_batch(std::span<const detail::constant_type_data *const> data)
+		{
+			auto entries = std::vector<detail::type_data *>(data.size());
+			impl_t::insert_batch(data, entries);
+
+			std::vector<type_info> result;
+			result.reserve(entries.size());
+			for (auto *entry: entries) result.push_back(type_info{entry});
+			return result;
+		}
+
+		/** Type initialization timing reported by `prewarm`. */
+		struct init_timing
+		{
+			/** Type info of the initialized type. */
+			type_info type;
+			/** Time spent initializing type metadata. */
+			std::chrono::nanoseconds duration;
+		};
+
+		/** Inserts and initializes types referenced by \a types in parallel on up to \a threads threads.
+		 * Metadata of the types is initialized outside of the database lock. If \a threads is `0`, uses all hardware threads.
+		 * @return Vector of init timings for every type, in the same order as \a types.
+		 * @note Types that have already been initialized are reported with near-zero timings. */
+		std::vector<init_timing> prewarm(std::span<const detail::type_handle> types, unsigned threads = 0)
+		{
+			const auto entries = impl_t::prewarm(types, threads);
+
+			std::vector<init_timing> result;
+			result.reserve(entries.size());
+			for (auto [entry, duration]: entries) result.push_back({type_info{entry}, duration});
+			return result;
+		}
+		/** @copydoc prewarm */
+		template<typename... Ts>
+		std::vector<init_timing> prewarm(unsigned threads = 0)
+		{
+			const auto types = std::array<detail::type_handle, sizeof...(Ts)>{detail::type_handle{detail::data_factory<std::decay_t<Ts>>}...};
+			return prewarm(types, threads);
+		}
+
+		/** Freezes the database into an immutable perfect hash image of all currently reflected types.
+		 * While frozen, `type_info::get(name)` and `type_query` take a single probe and never lock the database.
+		 * Types reflected after the database was frozen are still available, but are looked up through a slower overflow path.
+		 * Freezing an already frozen database rebuilds the image to include such types.
+		 * @return `true` if the image was built, `false` if reflected type names could not be perfectly hashed. */
+		bool freeze() { return impl_t::freeze(); }
+		/** Checks if the database has been frozen. */
+		[[nodiscard]] bool frozen() const noexcept { return impl_t::frozen(); }
+
 	public:
 		type_database(type_database &&) = default;
 		~type_database() = default;
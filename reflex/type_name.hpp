@@ -237,4 +237,36 @@ namespace reflex
 		[[nodiscard]] constexpr operator value_type() noexcept { return value; }
 		[[nodiscard]] constexpr value_type operator()() noexcept { return value; }
 	};
+
+	namespace detail
+	{
+		[[nodiscard]] constexpr std::uint64_t hash_mix(std::uint64_t h, std::uint64_t word) noexcept
+		{
+			h = (h ^ word) * 0x9e3779b97f4a7c15;
+			return h ^ (h >> 32);
+		}
+
+		/* Constexpr-friendly name hash, used for both compile-time type names and runtime name lookups.
+		 * Names are consumed 8 bytes at a time in order to keep runtime hashing of long template names cheap. */
+		[[nodiscard]] constexpr std::uint64_t name_hash(std::string_view str) noexcept
+		{
+			const auto read_word = [&](std::size_t pos, std::size_t n)
+			{
+				std::uint64_t word = 0;
+				for (std::size_t i = 0; i < n; ++i)
+					word |= static_cast<std::uint64_t>(static_cast<unsigned char>(str[pos + i])) << (i * 8);
+				return word;
+			};
+
+			auto h = static_cast<std::uint64_t>(0xcbf29ce484222325) ^ str.size();
+			std::size_t pos = 0;
+			for (; pos + 8 <= str.size(); pos += 8)
+				h = hash_mix(h, read_word(pos, 8));
+			return hash_mix(h, read_word(pos, str.size() - pos));
+		}
+	}
+
+	/** Compile-time hash of `type_name_v<T>`. Used to accelerate lookups of reflected type metadata. */
+	template<typename T>
+	inline constexpr std::uint64_t type_hash_v = detail::name_hash(type_name_v<T>);
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include <reflex/type_database.hpp>
+#include <chrono>
+#include <cstdio>
+#include <array>
+
+template<std::size_t... Is>
+static void reflect_arrays(std::index_sequence<Is...>) { (reflex::type_info::reflect<std::array<int, Is + 1>>(), ...); }
+template<std::size_t... Is>
+static auto array_names(std::index_sequence<Is...>) { return std::array{reflex::type_name_v<std::array<int, Is + 1>>...}; }
+
+/* Returns average latency of a single `type_info::get(name)` call in nanoseconds. */
+template<std::size_t N>
+static double measure(const std::array<std::string_view, N> &names, std::size_t rounds)
+{
+	std::size_t found = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < rounds; ++i)
+		for (auto name: names) found += reflex::type_info::get(name).valid();
+	const auto stop = std::chrono::steady_clock::now();
+
+	if (found != names.size() * rounds) std::abort();
+	return std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(found);
+}
+
+int main()
+{
+	constexpr std::size_t rounds = 10000;
+	constexpr auto seq = std::make_index_sequence<64>{};
+
+	reflect_arrays(seq);
+	const auto names = array_names(seq);
+
+	const auto unfrozen = measure(names, rounds);
+	reflex::type_database::instance()->freeze();
+	const auto frozen = measure(names, rounds);
+
+	std::printf("type lookup latency (%zu types): unfrozen %.2f ns, frozen %.2f ns\n", names.size(), unfrozen, frozen);
+}
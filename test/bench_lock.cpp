@@ -0,0 +1,51 @@
+#include <reflex/type_info.hpp>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#ifndef REFLEX_NO_THREADS
+/* Returns the amount of shared lock acquisitions per second, summed over \a threads reader threads. */
+template<typename L>
+static double read_throughput(unsigned threads)
+{
+	using namespace std::chrono_literals;
+
+	L lock;
+	std::atomic<bool> start = false, stop = false;
+	std::atomic<std::size_t> total = 0;
+
+	std::vector<std::thread> readers;
+	for (unsigned i = 0; i < threads; ++i)
+		readers.emplace_back([&]()
+		{
+			std::size_t n = 0;
+			while (!start) std::this_thread::yield();
+			for (; !stop.load(std::memory_order_relaxed); ++n)
+				const auto l = reflex::detail::shared_scoped_lock{lock};
+			total += n;
+		});
+
+	const auto begin = std::chrono::steady_clock::now();
+	start = true;
+	std::this_thread::sleep_for(200ms);
+	stop = true;
+	for (auto &reader: readers) reader.join();
+	const auto end = std::chrono::steady_clock::now();
+
+	return static_cast<double>(total) / std::chrono::duration<double>(end - begin).count();
+}
+
+int main()
+{
+	std::printf("%8s %20s %20s\n", "threads", "shared_spinlock", "scalable_shared_lock");
+	for (auto threads: {1u, 8u, 32u, 64u})
+	{
+		const auto spinlock = read_throughput<reflex::detail::shared_spinlock>(threads);
+		const auto scalable = read_throughput<reflex::detail::scalable_shared_lock>(threads);
+		std::printf("%8u %17.2f M/s %17.2f M/s\n", threads, spinlock / 1e6, scalable / 1e6);
+	}
+}
+#else
+int main() {}
+#endif
@@ -0,0 +1,150 @@
+#include "common.hpp"
+
+#include <string>
+
+struct test_small { std::uintptr_t a = 0, b = 0; };
+struct test_large { int values[12] = {}; };
+struct alignas(32) test_aligned { int value = 0; };
+struct test_shared_large { std::shared_ptr<int> ptr; int values[8] = {}; };
+
+template<typename T>
+static bool is_local(const T &owner) { return owner.cdata() >= static_cast<const void *>(&owner) && owner.cdata() < static_cast<const void *>(&owner + 1); }
+static const void *any_data(const reflex::any &value) { return value.cdata(); }
+
+void test_local()
+{
+	/* Trivial types of two words are stored in the local storage of `any`. */
+	const auto small = reflex::make_any<test_small>(test_small{1, 2});
+	TEST_ASSERT(is_local(small));
+	TEST_ASSERT(small.get<test_small>().b == 2);
+
+	const auto large = reflex::make_any<test_large>();
+	TEST_ASSERT(!is_local(large));
+
+	/* Small nothrow-movable types are stored locally & relocated through the type hooks. */
+	const auto ptr = std::make_shared<int>(1);
+	{
+		auto a = reflex::make_any<std::shared_ptr<int>>(ptr);
+		TEST_ASSERT(is_local(a));
+		TEST_ASSERT(ptr.use_count() == 2);
+
+		auto b = std::move(a);
+		TEST_ASSERT(a.empty() && is_local(b));
+		TEST_ASSERT(ptr.use_count() == 2);
+		TEST_ASSERT(*b.get<std::shared_ptr<int>>() == 1);
+
+		a = reflex::make_any<int>(2);
+		swap(a, b);
+		TEST_ASSERT(a.get<std::shared_ptr<int>>() == ptr && b.get<int>() == 2);
+		TEST_ASSERT(ptr.use_count() == 2);
+	}
+	TEST_ASSERT(ptr.use_count() == 1);
+}
+
+struct test_throwing { test_throwing() = default; test_throwing(test_throwing &&) noexcept(false) {} };
+
+void test_foreign_hooks()
+{
+	/* Values are allocated if their type info does not provide hooks to relocate & destroy them in-place. */
+	const auto ptr = std::make_shared<int>(1);
+	{
+		const auto type = reflex::type_info::get<test_throwing>();
+		auto a = reflex::any{type, std::in_place_type<std::shared_ptr<int>>, ptr};
+		TEST_ASSERT(!is_local(a) && ptr.use_count() == 2);
+
+		auto b = reflex::basic_any<64>{type, std::in_place_type<std::shared_ptr<int>>, ptr};
+		TEST_ASSERT(!is_local(b) && ptr.use_count() == 3);
+
+		auto c = reflex::make_any<int>(1);
+		swap(a, c);
+		b.swap(c);
+		TEST_ASSERT(ptr.use_count() == 3);
+	}
+	TEST_ASSERT(ptr.use_count() == 1);
+}
+
+void test_failed_assign()
+{
+	/* Failed copy-assignment leaves the target empty, instead of destroying its previous value twice. */
+	const auto ptr = std::make_shared<int>(1);
+	auto a = reflex::make_any<test_shared_large>(test_shared_large{ptr});
+	TEST_ASSERT(!is_local(a) && ptr.use_count() == 2);
+
+	const auto b = reflex::make_any<std::unique_ptr<int>>();
+	auto thrown = false;
+	try { a = b; }
+	catch (const reflex::bad_any_copy &) { thrown = true; }
+	TEST_ASSERT(thrown && a.empty() && ptr.use_count() == 1);
+}
+
+void test_basic_any()
+{
+	using any64 = reflex::basic_any<64>;
+
+	auto value = test_large{};
+	value.values[11] = 11;
+
+	auto a = any64{std::move(value)};
+	TEST_ASSERT(is_local(a));
+	TEST_ASSERT(a.get<test_large>().values[11] == 11);
+
+	/* `basic_any` is passed by reference to APIs taking `any`. */
+	TEST_ASSERT(any_data(a) == a.cdata());
+	TEST_ASSERT(a.try_cast<test_large>().cdata() == a.cdata());
+	TEST_ASSERT(reflex::type_of(a) == reflex::type_info::get<test_large>());
+
+	auto b = a;
+	TEST_ASSERT(is_local(b));
+	TEST_ASSERT(b.get<test_large>().values[11] == 11);
+
+	auto c = std::move(b);
+	TEST_ASSERT(is_local(c));
+	TEST_ASSERT(c.get<test_large>().values[11] == 11);
+
+	b.assign(std::in_place_type<int>, 1);
+	swap(b, c);
+	TEST_ASSERT(is_local(b) && b.get<test_large>().values[11] == 11);
+	TEST_ASSERT(c.get<int>() == 1);
+
+	/* Inline values are moved to the heap once they are moved into an `any`, which may throw. */
+	static_assert(std::is_nothrow_move_constructible_v<any64> && std::is_nothrow_swappable_v<any64>);
+	static_assert(!std::is_nothrow_move_constructible_v<reflex::any> && !std::is_nothrow_constructible_v<any64, reflex::any &&>);
+	auto d = reflex::any{std::move(b)};
+	TEST_ASSERT(!is_local(d));
+	TEST_ASSERT(d.get<test_large>().values[11] == 11);
+
+	auto &e = static_cast<reflex::any &>(a);
+	e.swap(d);
+	TEST_ASSERT(!is_local(a) && a.get<test_large>().values[11] == 11);
+	TEST_ASSERT(d.get<test_large>().values[11] == 11);
+
+	a = reflex::any{};
+	TEST_ASSERT(a.empty());
+
+	/* Non-trivial values are placed in the inline buffer as well. */
+	auto str = any64{std::in_place_type<std::string>, "inline string"};
+	TEST_ASSERT(is_local(str));
+
+	auto other = any64{std::in_place_type<std::string>, "other string"};
+	swap(str, other);
+	TEST_ASSERT(is_local(str) && str.get<std::string>() == "other string");
+	TEST_ASSERT(is_local(other) && other.get<std::string>() == "inline string");
+
+	auto moved = reflex::any{std::move(str)};
+	TEST_ASSERT(str.empty() && !is_local(moved));
+	TEST_ASSERT(moved.get<std::string>() == "other string");
+
+	/* Types aligned stricter than the buffer are never placed inline, regardless of the buffer's address. */
+	auto aligned = reflex::basic_any<64, 8>{std::in_place_type<test_aligned>};
+	TEST_ASSERT(!is_local(aligned));
+	auto aligned_moved = std::move(aligned);
+	TEST_ASSERT(!is_local(aligned_moved) && reinterpret_cast<std::uintptr_t>(aligned_moved.cdata()) % alignof(test_aligned) == 0);
+}
+
+int main()
+{
+	test_local();
+	test_foreign_hooks();
+	test_failed_assign();
+	test_basic_any();
+}
@@ -0,0 +1,63 @@
+#include "common.hpp"
+
+static_assert(REFLEX_CONVERSION_HOPS == 3, "Conversion chain tests must be built with REFLEX_CONVERSION_HOPS=3");
+
+enum class test_narrow : std::int8_t {};
+
+struct test_source { int value = 0; };
+
+template<std::size_t I>
+struct test_hop { int value = 0; };
+
+template<>
+struct reflex::type_init<test_source>
+{
+	void operator()(reflex::type_factory<test_source> f) const
+	{
+		/* Conversion through `float` is one hop shorter, but both of its conversions are lossy. */
+		f.make_convertible<float>([](const test_source &src) { return static_cast<float>(src.value + 100); });
+		f.make_convertible<test_narrow>([](const test_source &src) { return static_cast<test_narrow>(src.value); });
+	}
+};
+template<std::size_t I>
+struct reflex::type_init<test_hop<I>>
+{
+	void operator()(reflex::type_factory<test_hop<I>> f) const
+	{
+		if constexpr (I < 4) f.template make_convertible<test_hop<I + 1>>([](const test_hop<I> &src) { return test_hop<I + 1>{src.value + 1}; });
+	}
+};
+
+static void test_lossless_chain()
+{
+	/* Chains with fewer lossy conversions are preferred over shorter ones. */
+	const auto result = reflex::make_any<test_source>(test_source{7}).try_cast(reflex::type_info::get<std::int16_t>());
+	TEST_ASSERT(!result.empty() && result.get<std::int16_t>() == 7);
+}
+
+static void test_hop_limit()
+{
+	const auto value = reflex::make_any<test_hop<0>>();
+	const auto hop3 = value.try_cast(reflex::type_info::get<test_hop<3>>());
+	TEST_ASSERT(!hop3.empty() && hop3.get<test_hop<3>>().value == 3);
+
+	/* Chains longer than `REFLEX_CONVERSION_HOPS` are never used. */
+	TEST_ASSERT(value.try_cast(reflex::type_info::get<test_hop<4>>()).empty());
+}
+
+static void test_chain_invalidation()
+{
+	const auto value = reflex::make_any<test_hop<0>>();
+	TEST_ASSERT(value.try_cast(reflex::type_info::get<test_hop<3>>()).get<test_hop<3>>().value == 3);
+
+	/* Cached chains must be dropped once a conversion of an intermediate type changes. */
+	reflex::type_info::reflect<test_hop<2>>().make_convertible<test_hop<3>>([](const test_hop<2> &src) { return test_hop<3>{src.value * 10}; });
+	TEST_ASSERT(value.try_cast(reflex::type_info::get<test_hop<3>>()).get<test_hop<3>>().value == 20);
+}
+
+int main()
+{
+	test_lossless_chain();
+	test_hop_limit();
+	test_chain_invalidation();
+}
@@ -3,9 +3,247 @@
  */
 
 #include <reflex/type_database.hpp>
+#include <thread>
+#include <array>
 
 #include "common.hpp"
 
+template<std::size_t... Is>
+static void reflect_arrays(std::index_sequence<Is...>) { (reflex::type_info::reflect<std::array<int, Is + 1>>(), ...); }
+
+static void test_concurrent_find()
+{
+	/* Lookups must not block or fail while other types are being reflected. */
+	std::atomic<bool> done = false;
+	auto readers = std::array<std::thread, 4>{};
+	for (auto &reader: readers)
+		reader = std::thread{[&]() { while (!done) TEST_ASSERT(reflex::type_info::get("int").valid()); }};
+
+	reflect_arrays(std::make_index_sequence<64>{});
+	done = true;
+	for (auto &reader: readers) reader.join();
+
+	TEST_ASSERT(reflex::type_info::get(reflex::type_name_v<std::array<int, 64>>).valid());
+}
+
+template<typename T, std::size_t... Is>
+static void reflect_arrays(std::index_sequence<Is...>) { (reflex::type_info::reflect<std::array<T, Is + 1>>(), ...); }
+
+static void test_concurrent_insert()
+{
+	/* Concurrent registration of different types must not lose or duplicate entries. */
+	auto threads = std::array{
+			std::thread{[]() { reflect_arrays<short>(std::make_index_sequence<16>{}); }},
+			std::thread{[]() { reflect_arrays<long>(std::make_index_sequence<16>{}); }},
+			std::thread{[]() { reflect_arrays<float>(std::make_index_sequence<16>{}); }},
+	};
+	for (auto &t: threads) t.join();
+
+	TEST_ASSERT((reflex::type_info::get(reflex::type_name_v<std::array<short, 16>>) == reflex::type_info::get<std::array<short, 16>>()));
+	TEST_ASSERT((reflex::type_info::get(reflex::type_name_v<std::array<long, 16>>) == reflex::type_info::get<std::array<long, 16>>()));
+	TEST_ASSERT((reflex::type_info::get(reflex::type_name_v<std::array<float, 16>>) == reflex::type_info::get<std::array<float, 16>>()));
+}
+
+static void test_name_cache()
+{
+	auto cache = reflex::type_name_cache{};
+	TEST_ASSERT(!cache.get("not a type").valid());
+	TEST_ASSERT(cache.get("int") == reflex::type_info::get<int>());
+	TEST_ASSERT(cache.get("int") == reflex::type_info::get<int>());
+
+	/* Failed lookups must not be cached. */
+	TEST_ASSERT(!cache.get(reflex::type_name_v<std::array<int, 65>>).valid());
+	reflex::type_info::reflect<std::array<int, 65>>();
+	TEST_ASSERT(cache.get(reflex::type_name_v<std::array<int, 65>>).valid());
+}
+
+static void test_freeze()
+{
+	auto *db = reflex::type_database::instance();
+	reflex::type_info::reflect<double>();
+	TEST_ASSERT(db->freeze());
+	TEST_ASSERT(db->frozen());
+
+	/* Frozen lookups must find every type reflected before freezing. */
+	TEST_ASSERT(reflex::type_info::get("int").valid());
+	TEST_ASSERT(reflex::type_info::get("double") == reflex::type_info::get<double>());
+	TEST_ASSERT(reflex::type_info::get(reflex::type_name_v<std::array<int, 32>>).valid());
+	TEST_ASSERT(!reflex::type_info::get("not a type").valid());
+	TEST_ASSERT(reflex::type_info::query().types().contains(reflex::type_info::get<double>()));
+
+	/* Types reflected after freezing are reachable through the overflow path. */
+	TEST_ASSERT(!reflex::type_info::get("char").valid());
+	reflex::type_info::reflect<char>();
+	TEST_ASSERT(reflex::type_info::get("char").valid());
+	TEST_ASSERT(reflex::type_info::query().types().contains(reflex::type_info::get<char>()));
+
+	TEST_ASSERT(db->freeze());
+	TEST_ASSERT(reflex::type_info::get("char").valid());
+}
+
+struct lazy_type {};
+
+static bool lazy_type_init = false;
+
+template<>
+struct reflex::type_init<lazy_type> { void operator()(reflex::type_factory<lazy_type> f) { lazy_type_init = f.type().valid(); }};
+
+static void test_lazy_init()
+{
+	const auto type = reflex::type_info::get<lazy_type>();
+#ifdef REFLEX_LAZY_INIT
+	/* Metadata must only be initialized once it is queried. */
+	TEST_ASSERT(!lazy_type_init);
+#endif
+	TEST_ASSERT(type.constructible_from<>());
+	TEST_ASSERT(lazy_type_init);
+}
+
+static void test_reflect_all()
+{
+	reflex::type_info::reflect_all<short, long, std::array<float, 4>>();
+	TEST_ASSERT(reflex::type_info::get(reflex::type_name_v<short>).valid());
+	TEST_ASSERT(reflex::type_info::get(reflex::type_name_v<long>) == reflex::type_info::get<long>());
+	TEST_ASSERT((reflex::type_info::get<std::array<float, 4>>().size() == sizeof(float[4])));
+
+	/* Already reflected types must be left as-is. */
+	const auto id = reflex::type_info::get<short>().id();
+	reflex::type_info::reflect_all<short, unsigned short>();
+	TEST_ASSERT(reflex::type_info::get<short>().id() == id);
+	TEST_ASSERT(reflex::type_info::get(reflex::type_name_v<unsigned short>).valid());
+}
+
+static void test_prewarm()
+{
+	auto *db = reflex::type_database::instance();
+	using first_t = std::array<char, 1>;
+	using last_t = std::array<char, 4>;
+
+	const auto timings = db->prewarm<first_t, std::array<char, 2>, std::array<char, 3>, last_t>(2);
+	TEST_ASSERT(timings.size() == 4);
+	TEST_ASSERT(timings[0].type == reflex::type_info::get<first_t>());
+	TEST_ASSERT(timings[3].type == reflex::type_info::get<last_t>());
+
+	for (auto &timing: timings)
+		TEST_ASSERT(timing.type.constructible_from<>());
+}
+
+template<std::size_t I>
+struct nested_t {};
+template<std::size_t I>
+struct reflex::type_init<nested_t<I>> { void operator()(reflex::type_factory<nested_t<I>>) { if constexpr (I != 0) reflex::type_info::reflect<nested_t<I - 1>>(); }};
+
+static void test_nested_init()
+{
+	/* Initializers may reflect other types, including types of other shards, from multiple threads at once. */
+	auto threads = std::array{
+			std::thread{[]() { reflex::type_info::reflect<nested_t<32>>(); }},
+			std::thread{[]() { reflex::type_info::reflect<nested_t<33>>(); }},
+	};
+	for (auto &t: threads) t.join();
+
+	TEST_ASSERT(reflex::type_info::get(reflex::type_name_v<nested_t<0>>).valid());
+}
+
+template<std::size_t I>
+struct cyclic_t {};
+
+static std::atomic<int> cyclic_inits = 0;
+
+template<std::size_t I>
+struct reflex::type_init<cyclic_t<I>>
+{
+	void operator()(reflex::type_factory<cyclic_t<I>> f) const
+	{
+		/* Both initializers must be running before either of them uses the other type. */
+		++cyclic_inits;
+		while (cyclic_inits < 2) std::this_thread::yield();
+		TEST_ASSERT(!reflex::type_info::get<cyclic_t<1 - I>>().template has_attribute<float>());
+		f.attribute(reflex::make_any<int>(0));
+	}
+};
+
+static void test_cyclic_init()
+{
+	/* Initializers that use each other's types from different threads must not deadlock. */
+	auto threads = std::array{
+			std::thread{[]() { TEST_ASSERT(reflex::type_info::get<cyclic_t<0>>().has_attribute<int>()); }},
+			std::thread{[]() { TEST_ASSERT(reflex::type_info::get<cyclic_t<1>>().has_attribute<int>()); }},
+	};
+	for (auto &t: threads) t.join();
+
+	TEST_ASSERT(reflex::type_info::get<cyclic_t<0>>().has_attribute<int>());
+	TEST_ASSERT(reflex::type_info::get<cyclic_t<1>>().has_attribute<int>());
+}
+
+struct reset_t {};
+
+static std::atomic<int> reset_inits = 0;
+static std::atomic<bool> reset_go = false;
+
+template<>
+struct reflex::type_init<reset_t>
+{
+	void operator()(reflex::type_factory<reset_t> f) const
+	{
+		++reset_inits;
+		reset_inits.notify_all();
+		while (!reset_go) std::this_thread::yield();
+		f.attribute(reflex::make_any<int>(0));
+	}
+};
+
+static void test_concurrent_reset()
+{
+	/* Resetting a type must wait for its initialization by another thread, instead of clearing or re-initializing it concurrently. */
+	/* Result is not checked, since metadata may be reset again as soon as initialization completes. */
+	auto init = std::thread{[]() { static_cast<void>(reflex::type_info::get<reset_t>().has_attribute<int>()); }};
+	reset_inits.wait(0);
+
+	std::atomic<bool> reset_done = false;
+	auto reset = std::thread{[&]() { reflex::type_info::reset<reset_t>(); reset_done = true; }};
+	std::this_thread::sleep_for(std::chrono::milliseconds{20});
+	TEST_ASSERT(!reset_done && reset_inits == 1);
+
+	reset_go = true;
+	init.join();
+	reset.join();
+	TEST_ASSERT(reflex::type_info::get<reset_t>().has_attribute<int>());
+}
+
+struct foreign_a {};
+struct foreign_b {};
+
+static void test_foreign_any()
+{
+	/* Moved-from databases restart type IDs at 0, so values of one database must not match types of another by ID. */
+	auto *db = reflex::type_database::instance();
+	static auto db_a = reflex::type_database{std::move(*db)};
+	const auto value = reflex::make_any<foreign_a>();
+	static auto db_b = reflex::type_database{std::move(*db)};
+	reflex::type_info::reflect<foreign_b>();
+
+	TEST_ASSERT(value.type().id() == reflex::type_info::get<foreign_b>().id());
+	TEST_ASSERT(value.try_get<foreign_b>() == nullptr);
+	TEST_ASSERT(value.try_get<foreign_a>() != nullptr);
+}
+
+struct destroyed_t {};
+
+static void test_destroyed_database()
+{
+	/* Cached entries of destroyed databases must be rejected without being accessed. */
+	auto *db = reflex::type_database::instance();
+	{
+		auto tmp = reflex::type_database{std::move(*db)};
+		reflex::type_database::instance(&tmp);
+		reflex::type_info::reflect<destroyed_t>();
+		reflex::type_database::instance(db);
+	}
+	TEST_ASSERT(!reflex::type_info::get(reflex::type_name_v<destroyed_t>).valid());
+	TEST_ASSERT(reflex::type_info::get<destroyed_t>().valid());
+}
+
 int main()
 {
 	const auto old_db = reflex::type_database::instance();
@@ -13,9 +251,35 @@ int main()
 
 	reflex::type_info::reflect<int>();
 	TEST_ASSERT(reflex::type_info::get("int").valid());
+	/* Compile-time type names must not be copied. */
+	TEST_ASSERT(reflex::type_info::get("int").name().data() == reflex::type_name_v<int>.data());
+	TEST_ASSERT(reflex::type_info::get("int").id() == reflex::type_info::get<int>().id());
+	TEST_ASSERT(reflex::type_info::get<int>().id() != reflex::type_info::get<float>().id());
+	TEST_ASSERT(reflex::type_info{}.id() == reflex::type_info::invalid_id);
+
+	/* Handles reach their database via the type entry, which follows the entry when the database is moved. */
+	TEST_ASSERT(sizeof(reflex::type_info) == sizeof(void *));
+	const auto value = reflex::make_any<int>(1);
 
 	auto new_db = reflex::type_database{std::move(*old_db)};
 	TEST_ASSERT(reflex::type_database::instance(&new_db) == old_db);
 	TEST_ASSERT(reflex::type_database::instance() == &new_db);
+	TEST_ASSERT(reflex::type_info::get<int>() == reflex::type_info::get("int"));
 	TEST_ASSERT(reflex::type_info::get("int").valid());
-}
\ No newline at end of file
+	TEST_ASSERT(reflex::type_info::get("int").id() == reflex::type_info::get<int>().id());
+	TEST_ASSERT(value.type() == reflex::type_info::get<int>());
+	TEST_ASSERT(!value.type().constructors().empty());
+
+	test_concurrent_find();
+	test_concurrent_insert();
+	test_name_cache();
+	test_freeze();
+	test_reflect_all();
+	test_lazy_init();
+	test_prewarm();
+	test_nested_init();
+	test_cyclic_init();
+	test_concurrent_reset();
+	test_foreign_any();
+	test_destroyed_database();
+}
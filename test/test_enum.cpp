@@ -43,4 +43,12 @@ int main()
 	TEST_ASSERT(e1.type() == enum_ti);
 	TEST_ASSERT(e0.get<test_enum>() == test_value_0);
 	TEST_ASSERT(e1.get<test_enum>() == test_value_1);
+
+#if REFLEX_CONVERSION_HOPS > 1 && !defined(REFLEX_NO_ARITHMETIC)
+	/* Enums are convertible to other arithmetic types through their underlying type. */
+	const auto d1 = e1.try_cast(reflex::type_info::get<double>());
+	TEST_ASSERT(!d1.empty() && d1.get<double>() == 1.0);
+#elif REFLEX_CONVERSION_HOPS == 1
+	TEST_ASSERT(e1.try_cast(reflex::type_info::get<double>()).empty());
+#endif
 }
\ No newline at end of file
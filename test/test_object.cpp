@@ -2,6 +2,10 @@
  * Created by switchblade on 2023-03-30.
  */
 
+#include <thread>
+#include <memory>
+#include <array>
+
 #include "common.hpp"
 
 class test_base : public reflex::object
@@ -24,6 +28,21 @@ public:
 template<>
 struct reflex::type_init<test_child> { void operator()(reflex::type_factory<test_child> f) { f.add_parent<test_base>(); }};
 
+struct test_left { int left = 0; };
+struct test_right { int right = 1; };
+struct test_multi : test_left, test_right {};
+struct test_grandchild : test_multi {};
+struct test_virtual : virtual test_right {};
+
+template<>
+struct reflex::type_init<test_right> { void operator()(reflex::type_factory<test_right> f) { f.make_convertible<int>([](const test_right &r) { return r.right; }); }};
+template<>
+struct reflex::type_init<test_multi> { void operator()(reflex::type_factory<test_multi> f) { f.add_parent<test_left>().add_parent<test_right>(); }};
+template<>
+struct reflex::type_init<test_grandchild> { void operator()(reflex::type_factory<test_grandchild> f) { f.add_parent<test_multi>(); }};
+template<>
+struct reflex::type_init<test_virtual> { void operator()(reflex::type_factory<test_virtual> f) { f.add_parent<test_right>(); }};
+
 void test_object_info()
 {
 	TEST_ASSERT(reflex::type_info::get<reflex::object>().is_abstract());
@@ -38,8 +57,16 @@ void test_object_info()
 
 	TEST_ASSERT(child_ti.inherits_from<reflex::object>());
 	TEST_ASSERT(child_ti.inherits_from<test_base>());
+	TEST_ASSERT(child_ti.inherits_from(base_ti));
+	TEST_ASSERT(!base_ti.inherits_from(child_ti));
+	TEST_ASSERT(!child_ti.inherits_from(child_ti));
 	TEST_ASSERT(!child_ti.is_abstract());
 
+	const auto parents = child_ti.parents();
+	TEST_ASSERT(parents.size() == 2);
+	TEST_ASSERT(parents.contains(base_ti));
+	TEST_ASSERT(parents.contains(reflex::type_info::get<reflex::object>()));
+
 	const auto objects = reflex::type_info::query().inherits_from<reflex::object>().types();
 	TEST_ASSERT(objects.contains(base_ti));
 	TEST_ASSERT(objects.contains(child_ti));
@@ -89,6 +116,137 @@ void test_object_cast()
 	TEST_ASSERT(reflex::object_cast<const test_base>(object_ptr) == &child);
 }
 
+/* Even leaves derive from `test_child`, odd leaves derive from `test_base` only. */
+template<std::size_t I>
+using test_leaf_parent = std::conditional_t<I % 2 == 0, test_child, test_base>;
+template<std::size_t I>
+class test_leaf : public test_leaf_parent<I>
+{
+	REFLEX_DEFINE_OBJECT(test_leaf)
+};
+template<std::size_t I>
+struct reflex::type_init<test_leaf<I>> { void operator()(reflex::type_factory<test_leaf<I>> f) { f.template add_parent<test_leaf_parent<I>>(); }};
+
+struct test_unrelated {};
+
+void test_concurrent_object_cast()
+{
+	/* There are more leaf types than entries of the inline cache, so that entries are constantly replaced. */
+	const auto leaves = []<std::size_t... Is>(std::index_sequence<Is...>)
+	{
+		return std::array<std::unique_ptr<test_base>, sizeof...(Is)>{std::make_unique<test_leaf<Is>>()...};
+	}(std::make_index_sequence<8>{});
+	for (std::size_t i = 0; i < leaves.size(); ++i) TEST_ASSERT(reflex::type_of(*leaves[i]).inherits_from<test_child>() == (i % 2 == 0));
+
+	/* Inheritance graph version is bumped concurrently by changes to an unrelated type. */
+	std::atomic<bool> done = false;
+	auto writer = std::thread{[&]()
+	{
+		while (!done)
+		{
+			reflex::type_info::reflect<test_unrelated>().make_convertible<int>([](const test_unrelated &) { return 0; });
+			TEST_ASSERT(!reflex::type_info::get<test_unrelated>().inherits_from<test_base>());
+		}
+	}};
+
+	auto readers = std::array<std::thread, 4>{};
+	for (std::size_t i = 0; i < readers.size(); ++i)
+		readers[i] = std::thread{[&, i]()
+		{
+			for (std::size_t j = 0; j < 20000; ++j)
+			{
+				const auto pos = (i + j) % leaves.size();
+				TEST_ASSERT((reflex::object_cast<test_child>(leaves[pos].get()) != nullptr) == (pos % 2 == 0));
+			}
+		}};
+	for (auto &reader: readers) reader.join();
+	done = true;
+	writer.join();
+}
+
+void test_retired_tables()
+{
+	/* Dropped ancestor tables must be freed once no reader may reference them, instead of accumulating with every change. */
+	const auto *db = reflex::detail::database_impl::instance();
+	for (std::size_t i = 0; i < 64; ++i)
+	{
+		reflex::type_info::reflect<test_unrelated>().make_convertible<int>([](const test_unrelated &) { return 0; });
+		TEST_ASSERT(!reflex::type_info::get<test_unrelated>().inherits_from<test_base>());
+	}
+	TEST_ASSERT(db->m_retired_tables.empty());
+}
+
+void test_base_cast()
+{
+	auto grandchild = test_grandchild{};
+	auto grandchild_any = reflex::forward_any(grandchild);
+	TEST_ASSERT(grandchild_any.try_as<test_multi>() == static_cast<test_multi *>(&grandchild));
+	TEST_ASSERT(grandchild_any.try_as<test_left>() == static_cast<test_left *>(&grandchild));
+	TEST_ASSERT(grandchild_any.try_as<test_right>() == static_cast<test_right *>(&grandchild));
+	TEST_ASSERT(grandchild_any.try_as<test_right>()->right == 1);
+
+	auto virtual_child = test_virtual{};
+	auto virtual_any = reflex::forward_any(virtual_child);
+	TEST_ASSERT(virtual_any.try_as<test_right>() == static_cast<test_right *>(&virtual_child));
+	TEST_ASSERT(virtual_any.try_as<test_left>() == nullptr);
+
+	/* Repeated casts use the cached cast path. */
+	for (int i = 0; i < 2; ++i)
+	{
+		const auto right_any = grandchild_any.try_cast(reflex::type_info::get<test_right>());
+		TEST_ASSERT(right_any.cdata() == static_cast<test_right *>(&grandchild));
+
+		const auto int_any = grandchild_any.try_cast(reflex::type_info::get<int>());
+		TEST_ASSERT(!int_any.empty() && int_any.get<int>() == 1);
+
+		TEST_ASSERT(grandchild_any.try_cast(reflex::type_info::get<test_virtual>()).empty());
+	}
+
+	/* Conversions added after the type was used invalidate cached lookups. */
+	const auto string_ti = reflex::type_info::get<std::string>();
+	TEST_ASSERT(!reflex::type_info::get<test_multi>().convertible_to(string_ti));
+	TEST_ASSERT(grandchild_any.try_cast(string_ti).empty());
+
+	reflex::type_info::reflect<test_left>().make_convertible<std::string>([](const test_left &l) { return std::to_string(l.left); });
+	TEST_ASSERT(reflex::type_info::get<test_multi>().convertible_to(string_ti));
+	TEST_ASSERT(!grandchild_any.try_cast(string_ti).empty());
+}
+
+struct test_member { int value = 0; };
+struct test_owner { int padding = 0; test_member member; };
+
+void test_runtime_parent()
+{
+	/* Parents added by type info are resolved to the parent's entry directly. */
+	reflex::type_info::reflect<test_owner>().add_parent(reflex::type_info::get<test_member>(), [](const void *ptr) -> const void *
+	{
+		return &static_cast<const test_owner *>(ptr)->member;
+	});
+
+	auto owner = test_owner{};
+	TEST_ASSERT(reflex::type_info::get<test_owner>().inherits_from<test_member>());
+	TEST_ASSERT(reflex::forward_any(owner).try_as<test_member>() == &owner.member);
+}
+
+void test_inherited_facets()
+{
+	using range_group = reflex::facets::facet_group<reflex::facets::range, reflex::facets::tuple>;
+	const auto &array_vtabs = reflex::facets::impl_facet_v<range_group, std::array<int, 2>>;
+	const auto &other_range = reflex::facets::impl_facet_v<reflex::facets::range, std::array<int, 3>>;
+
+	/* Facets are inherited from all ancestors, not only from immediate bases. */
+	reflex::type_info::reflect<test_left>().implement_facet<range_group>(array_vtabs);
+	const auto grandchild_ti = reflex::type_info::get<test_grandchild>();
+	TEST_ASSERT(grandchild_ti.implements_facet<range_group>());
+	TEST_ASSERT(grandchild_ti.facet<reflex::facets::range>(reflex::any{}).vtable() == std::get<0>(array_vtabs));
+	TEST_ASSERT(grandchild_ti.facet<reflex::facets::tuple>(reflex::any{}).vtable() == std::get<1>(array_vtabs));
+
+	/* Facets implemented by nearer types take precedence. */
+	reflex::type_info::reflect<test_multi>().implement_facet<reflex::facets::range>(other_range);
+	TEST_ASSERT(grandchild_ti.facet<reflex::facets::range>(reflex::any{}).vtable() == &other_range);
+	TEST_ASSERT(reflex::type_info::get<test_left>().facet<reflex::facets::range>(reflex::any{}).vtable() == std::get<0>(array_vtabs));
+}
+
 void test_exceptions()
 {
 	constexpr auto do_test = []<typename U>(U &&value)
@@ -122,5 +280,10 @@ int main()
 {
 	test_object_info();
 	test_object_cast();
+	test_concurrent_object_cast();
+	test_retired_tables();
+	test_base_cast();
+	test_runtime_parent();
+	test_inherited_facets();
 	test_exceptions();
 }
\ No newline at end of file
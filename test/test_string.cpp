@@ -23,6 +23,11 @@ int main()
 	TEST_ASSERT((str_ti.constructible_from({{reflex::type_info::get<std::string_view>(), arg_flags::is_value}})));
 	TEST_ASSERT((str_ti.constructible_from<std::string_view>()));
 
+	const auto rt_args = reflex::argument_list{{reflex::type_info::get<std::string_view>(), arg_flags::is_value}};
+	const auto ct_args = reflex::argument_list{reflex::type_pack<std::string_view>};
+	TEST_ASSERT(rt_args.size() == 1 && rt_args[0] == ct_args[0]);
+	TEST_ASSERT(!(rt_args[0] == reflex::argument_list{reflex::type_pack<const std::string_view &>}[0]));
+
 	TEST_ASSERT((str_ti.convertible_to<std::string_view>()));
 
 	const auto str0 = str_ti.construct(str_val);